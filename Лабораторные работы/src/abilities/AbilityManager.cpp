@@ -6,19 +6,13 @@
 #include "AbilityException.h"
 #include <algorithm>
 #include <random>
-#include <ctime>
 #include <cctype>
 #include <string>
 
 
-static std::mt19937& rng() {
-    static std::mt19937 gen(static_cast<unsigned int>(std::time(nullptr)));
-    return gen;
-}
-
 std::shared_ptr<Ability> AbilityManager::GenerateRandomAbility() {
     std::uniform_int_distribution<int> dist(0, 2);
-    switch (dist(rng())) {
+    switch (dist(rng_)) {
         case 0: return std::make_shared<Scanner>();
         case 1: return std::make_shared<DoubleDamage>();
         case 2: return std::make_shared<Shelling>();
@@ -26,8 +20,8 @@ std::shared_ptr<Ability> AbilityManager::GenerateRandomAbility() {
     }
 }
 
-AbilityManager::AbilityManager(PlayingField& enemy, PlayingField& self)
-    : enemy_field_(enemy), field_(self) {
+AbilityManager::AbilityManager(PlayingField& enemy, PlayingField& self, Rng& rng)
+    : enemy_field_(enemy), field_(self), rng_(rng) {
     InitializeThreeUniqueAbilities();
 }
 
@@ -37,10 +31,15 @@ std::pair<int, int> AbilityManager::ApplyNextAbility(int x, int y) {
     }
     auto ability = std::move(ability_queue_.front());
     ability_queue_.pop();
+    last_outcomes_.clear();
     ability->Use(*this, x, y);
     return ability->coordinates();
 }
 
+const std::vector<AbilityOutcome>& AbilityManager::last_outcomes() const {
+    return last_outcomes_;
+}
+
 void AbilityManager::AddNextAbility() {
     ability_queue_.push(GenerateRandomAbility());
 }
@@ -73,7 +72,9 @@ int AbilityManager::enemy_field_size_y() const {
 }
 
 void AbilityManager::DamageEnemyField(int x, int y, int dam) {
-    if (enemy_field_.Damage(x, y, dam) == 2) {
+    const int result = enemy_field_.Damage(x, y, dam);
+    last_outcomes_.push_back({x, y, dam, result});
+    if (result == 2) {
         AddNextAbility();
     }
 }
@@ -106,6 +107,7 @@ std::string AbilityManager::PrintAbilities() const {
 
 void AbilityManager::set_enemy_cell_visible(int x, int y) {
     enemy_field_.set_cell_visible(x, y);
+    last_outcomes_.push_back({x, y, 0, enemy_field_.IsShipCell(x, y) ? 1 : 0});
 }
 
 bool AbilityManager::enemy_cell_state(int x, int y) const {
@@ -122,7 +124,7 @@ void AbilityManager::InitializeThreeUniqueAbilities() {
     abilities.push_back(std::make_shared<Scanner>());
     abilities.push_back(std::make_shared<Shelling>());
 
-    std::shuffle(abilities.begin(), abilities.end(), rng());
+    std::shuffle(abilities.begin(), abilities.end(), rng_);
     for (auto& a : abilities) {
         ability_queue_.push(a);
     }
@@ -145,7 +147,11 @@ void AbilityManager::set_ability_queue(std::queue<std::shared_ptr<Ability>> new_
 
 
 int AbilityManager::ship_count() const {
-    return enemy_field_.count();
+    return enemy_field_.ship_slot_count();
+}
+
+bool AbilityManager::IsShipPlaced(int index) const {
+    return enemy_field_.IsShipPlaced(index);
 }
 
 std::ostream& operator<<(std::ostream& os, const AbilityManager& m) {
@@ -188,6 +194,10 @@ std::queue<std::shared_ptr<Ability>> AbilityManager::ability_queue() const {
     return ability_queue_; 
 }
 
+Rng& AbilityManager::rng() {
+    return rng_;
+}
+
 bool AbilityManager::HasAbilities() const {
     return !ability_queue_.empty(); 
 }
\ No newline at end of file
@@ -5,18 +5,31 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include <iostream>
+#include "core/Random.h"
 
 class Ability; 
 class PlayingField;
 class Ship;
 
+// Что способность сделала с клеткой поля противника. Выстрел: damage — нанесённый урон, result —
+// ответ PlayingField::Damage. Сканер: damage равен 0, result — 1, если в клетке корабль, иначе 0.
+struct AbilityOutcome {
+    int x;
+    int y;
+    int damage;
+    int result;
+};
+
 class AbilityManager {
 public:
     AbilityManager() = default;
-    AbilityManager(PlayingField& enemy, PlayingField& self);
+    AbilityManager(PlayingField& enemy, PlayingField& self, Rng& rng);
 
     std::pair<int, int> ApplyNextAbility(int x, int y); 
+    // Клетки, которые затронула последняя применённая способность.
+    const std::vector<AbilityOutcome>& last_outcomes() const;
     void AddNextAbility();
     void InitializeThreeUniqueAbilities();
     void reset(); 
@@ -32,7 +45,9 @@ public:
     int enemy_field_size_x() const;
     int enemy_field_size_y() const;
     int ship_count() const;
+    bool IsShipPlaced(int index) const;
     std::queue<std::shared_ptr<Ability>> ability_queue() const;
+    Rng& rng();
 
     void DamageEnemyField(int x, int y, int dam = 1);
     void set_enemy_cell_visible(int x, int y);
@@ -50,8 +65,10 @@ private:
     std::shared_ptr<Ability> GenerateRandomAbility();
 
     std::queue<std::shared_ptr<Ability>> ability_queue_;
+    std::vector<AbilityOutcome> last_outcomes_;
     PlayingField& enemy_field_ ;
     PlayingField& field_ ;
+    Rng& rng_;
 };
 
 #endif
\ No newline at end of file
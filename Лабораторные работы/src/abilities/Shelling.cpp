@@ -2,6 +2,7 @@
 #include "AbilityException.h"
 #include "AbilityManager.h"
 #include <algorithm>
+#include <random>
 
 Shelling::Shelling() : Ability("Shelling") { 
     description_ = "Наносит 1 урон случайному живому сегменту.";
@@ -13,6 +14,7 @@ std::vector<std::pair<int,int>> Shelling::CollectAliveTargets(AbilityManager& ma
 
     const int count_ = manager.ship_count();
     for (int i = 0; i < count_; ++i) {
+        if (!manager.IsShipPlaced(i)) continue;
         const Ship& ship = manager.ship(i);
         if (ship.IsDestroyed()) continue;
 
@@ -27,10 +29,9 @@ std::vector<std::pair<int,int>> Shelling::CollectAliveTargets(AbilityManager& ma
     return targets;
 }
 
-int Shelling::RandomIndex(int n) {
-    static thread_local std::mt19937 gen{std::random_device{}()};
+int Shelling::RandomIndex(Rng& rng, int n) {
     std::uniform_int_distribution<> dist(0, n - 1);
-    return dist(gen);
+    return dist(rng);
 }
 
 void Shelling::Use(AbilityManager& manager, int /*x*/, int /*y*/) {
@@ -43,7 +44,7 @@ void Shelling::Use(AbilityManager& manager, int /*x*/, int /*y*/) {
         const int maxTries = std::min<int>(5, static_cast<int>(targets.size()));
 
         for (int attempt = 0; attempt < maxTries; ++attempt) {
-            const int idx = RandomIndex(static_cast<int>(targets.size()));
+            const int idx = RandomIndex(manager.rng(), static_cast<int>(targets.size()));
             auto [x, y] = targets[idx];
 
             try {
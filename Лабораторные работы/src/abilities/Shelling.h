@@ -1,10 +1,10 @@
 #ifndef BATTLESHIP_ABILITIES_SHELLING_H_
 #define BATTLESHIP_ABILITIES_SHELLING_H_
 
-#include <random>
 #include <vector>
 #include <utility>
 #include "Ability.h"
+#include "core/Random.h"
 #include "core/Ship.h"
 
 class AbilityManager;
@@ -16,7 +16,7 @@ public:
 
 private:
     std::vector<std::pair<int,int>> CollectAliveTargets(AbilityManager& manager) const;
-    static int RandomIndex(int n);
+    static int RandomIndex(Rng& rng, int n);
 };
 
 #endif
@@ -9,6 +9,12 @@ public:
     ShipPlacementException(const std::string& msg) : std::runtime_error(std::string("Ошибка кораблей: ") + msg) {}
 };
 
+class InvalidShipSizeException : public ShipPlacementException {
+public:
+    InvalidShipSizeException(int size) :
+        ShipPlacementException("Недопустимый размер корабля: " + std::to_string(size)) {}
+};
+
 class ShipOutOfBoundsException : public ShipPlacementException {
 public:
     ShipOutOfBoundsException(int x, int y, int x_size, int y_size) :
@@ -0,0 +1,130 @@
+#include "AIMovePlanner.h"
+#include <chrono>
+
+
+
+AIMovePlanner::~AIMovePlanner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+
+void AIMovePlanner::Configure(const GameSettings& settings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.budget = settings.ai_move_budget();
+    config_.timed = !settings.seed().has_value();
+    config_.posterior = settings.posterior_settings();
+    config_.posterior.samples = config_.budget.samples;
+    config_.endgame = settings.endgame_settings();
+    ++config_version_;
+    // Ход, посчитанный с прежними настройками, больше не годится.
+    job_.state = JobState::EMPTY;
+    ++ticket_;
+}
+
+
+void AIMovePlanner::Speculate(const AIObservation& observation, const Rng& rng, std::uint64_t revision) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Matches(rng, revision)) {
+        Submit(observation, rng, revision);
+    }
+}
+
+
+bool AIMovePlanner::Take(const AIObservation& observation, Rng& rng, std::uint64_t revision, int& x, int& y) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Matches(rng, revision)) {
+        Submit(observation, rng, revision);
+    }
+    const std::uint64_t ticket = ticket_;
+    done_.wait(lock, [&] { return job_.state == JobState::DONE || ticket_ != ticket; });
+    if (ticket_ != ticket) {
+        // Настройки поменялись, пока ход считался: считать заново уже не для кого.
+        return false;
+    }
+
+    job_.state = JobState::EMPTY;
+    rng = job_.rng_after;
+    x = job_.x;
+    y = job_.y;
+    return job_.found;
+}
+
+
+void AIMovePlanner::Submit(const AIObservation& observation, const Rng& rng, std::uint64_t revision) {
+    job_.state = JobState::QUEUED;
+    job_.revision = revision;
+    job_.observation = observation;
+    job_.rng_before = rng;
+    ++ticket_;
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&AIMovePlanner::WorkerLoop, this);
+    }
+    wake_.notify_one();
+}
+
+
+bool AIMovePlanner::Matches(const Rng& rng, std::uint64_t revision) const {
+    return job_.state != JobState::EMPTY && job_.revision == revision && job_.rng_before == rng;
+}
+
+
+void AIMovePlanner::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stop_ || job_.state == JobState::QUEUED; });
+        if (stop_) {
+            return;
+        }
+
+        const std::uint64_t ticket = ticket_;
+        const std::uint64_t config_version = config_version_;
+        const Config config = config_;
+        AIObservation observation = job_.observation;
+        Rng rng = job_.rng_before;
+        job_.state = JobState::RUNNING;
+        lock.unlock();
+
+        if (applied_config_version_ != config_version) {
+            applied_config_version_ = config_version;
+            strategy_ = MakeStrategy(config);
+        }
+        int x = -1, y = -1;
+        const bool found = Choose(config, observation, rng, x, y);
+
+        lock.lock();
+        if (ticket_ != ticket) {
+            continue;
+        }
+        job_.rng_after = rng;
+        job_.found = found;
+        job_.x = x;
+        job_.y = y;
+        job_.state = JobState::DONE;
+        done_.notify_all();
+    }
+}
+
+
+bool AIMovePlanner::Choose(const Config& config, AIObservation& observation, Rng& rng, int& x, int& y) {
+    // Ход ищется, пока не кончится время: в конце раунда — точный перебор, иначе выборки
+    // расстановок; если ни то ни другое не успело, остаётся быстрый ход по плотности позиций.
+    const TargetingStrategy::Deadline deadline = config.timed
+        ? std::chrono::steady_clock::now() + config.budget.time
+        : TargetingStrategy::Deadline::max();
+    return strategy_->ChooseTarget(observation, rng, x, y, deadline);
+}
+
+
+std::unique_ptr<TargetingStrategy> AIMovePlanner::MakeStrategy(const Config& config) {
+    if (config.budget.samples <= 0) {
+        return std::make_unique<DensityTargeting>();
+    }
+    return std::make_unique<PosteriorTargeting>(config.posterior, config.endgame);
+}
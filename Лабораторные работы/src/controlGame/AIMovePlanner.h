@@ -0,0 +1,90 @@
+#ifndef BATTLESHIP_CONTROLGAME_AIMOVEPLANNER_H_
+#define BATTLESHIP_CONTROLGAME_AIMOVEPLANNER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "GameSettings.h"
+#include "core/AIObservation.h"
+#include "core/Random.h"
+#include "core/TargetingStrategy.h"
+
+// Выбор хода ИИ в отдельном потоке.
+//
+// Ход ИИ зависит только от его наблюдения и генератора ИИ, а пока игрок целится, они
+// не меняются. Поэтому ход можно начать считать, как только начался ход игрока: Speculate
+// ставит задачу на копиях наблюдения и генератора, а Take забирает готовый ход, если задача
+// была для той же ревизии наблюдения и того же состояния генератора, дожидается ещё
+// считающейся задачи или ставит новую и ждёт её. После Take генератор в том же состоянии,
+// как если бы ход считался на месте, поэтому партия с заданным зерном не зависит от того,
+// успел ли поток. Стратегия стрельбы живёт в потоке планировщика.
+class AIMovePlanner {
+public:
+    AIMovePlanner() = default;
+    ~AIMovePlanner();
+
+    AIMovePlanner(const AIMovePlanner&) = delete;
+    AIMovePlanner& operator=(const AIMovePlanner&) = delete;
+
+    // Сложность и настройки поиска для следующих задач.
+    void Configure(const GameSettings& settings);
+
+    // Начать считать ход заранее. Повторный вызов для той же ревизии ничего не делает.
+    void Speculate(const AIObservation& observation, const Rng& rng, std::uint64_t revision);
+
+    // Ход для наблюдения с этой ревизией. Возвращает false, если стрелять некуда.
+    bool Take(const AIObservation& observation, Rng& rng, std::uint64_t revision, int& x, int& y);
+
+private:
+    struct Config {
+        AIMoveBudget budget{};
+        // Ограничивать ли ход по времени; с заданным зерном — только по числу расстановок.
+        bool timed = true;
+        PosteriorSettings posterior;
+        EndgameSettings endgame;
+    };
+
+    enum class JobState {
+        EMPTY,
+        QUEUED,
+        RUNNING,
+        DONE
+    };
+
+    struct Job {
+        JobState state = JobState::EMPTY;
+        std::uint64_t revision = 0;
+        AIObservation observation;
+        Rng rng_before;
+        Rng rng_after;
+        bool found = false;
+        int x = -1;
+        int y = -1;
+    };
+
+    void Submit(const AIObservation& observation, const Rng& rng, std::uint64_t revision);
+    bool Matches(const Rng& rng, std::uint64_t revision) const;
+    void WorkerLoop();
+    // Сам выбор хода; вызывается только из потока планировщика.
+    bool Choose(const Config& config, AIObservation& observation, Rng& rng, int& x, int& y);
+    static std::unique_ptr<TargetingStrategy> MakeStrategy(const Config& config);
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    Config config_;
+    std::uint64_t config_version_ = 0;
+    Job job_;
+    // Номер последней поставленной задачи: результат заменённой задачи выбрасывается.
+    std::uint64_t ticket_ = 0;
+    bool stop_ = false;
+    std::thread worker_;
+
+    // Принадлежат потоку планировщика.
+    std::uint64_t applied_config_version_ = 0;
+    std::unique_ptr<TargetingStrategy> strategy_;
+};
+
+#endif
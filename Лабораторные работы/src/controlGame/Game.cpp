@@ -32,13 +32,27 @@ void Game::CreateShipManager(){
 void Game::Initialize(){
     const int size = settings_.field_size();
     CreateShipManager();
+
+    // Каждая партия получает свои потоки случайности; с заданным зерном партия повторяется.
+    current_state_.set_random(GameRandom(settings_.seed().value_or(GameRandom::FreshSeed())));
+    ai_planner_.Configure(settings_);
+
+    // Расстановки для автоматического режима начинают готовиться в фоне уже сейчас.
+    LayoutPool& pool = LayoutPool::getInstance();
+    pool.Configure(settings_.layout_pool_settings());
+    std::vector<int> fleet(ship_manager_->ship_count());
+    for (int i = 0; i < ship_manager_->ship_count(); ++i) {
+        fleet[i] = ship_manager_->ship_size(i);
+    }
+    pool.Prefetch(size, size, fleet, current_state_.random().placement());
+
     human_player_ = std::make_unique<Player>(human_name_, PlayerType::HUMAN, ship_manager_, size, size);
     ai_player_ = std::make_unique<Player>("AI", PlayerType::AI, ship_manager_, size, size);
     set_players(std::move(human_player_), std::move(ai_player_));
 }
 
 void Game::MoveAIShips() {
-    if (!ai_player_->PlaceShipsRandomly()) {
+    if (!ai_player_->PlaceShipsRandomly(current_state_.random().placement(), placement_strategy_)) {
         settings_.ResetFieldAndShipSize();
         Initialize();
         throw ImpossibleFleetException();
@@ -46,7 +60,7 @@ void Game::MoveAIShips() {
 }
 
 void Game::MoveRandomShips() {
-    if (!human_player_->PlaceShipsRandomly()) {
+    if (!human_player_->PlaceShipsRandomly(current_state_.random().placement(), placement_strategy_)) {
         settings_.ResetFieldAndShipSize();
         Initialize();
         throw ImpossibleFleetException();
@@ -60,6 +74,10 @@ std::pair<int, Orientation> Game::current_ship_info() const {
 }
 
 
+PlacementStatus Game::ship_placement_status(int x, int y) const {
+    return human_player_->field().CanPlace(x, y, current_ship_size(), ship_orientation());
+}
+
 int Game::current_ship_size() const {
     if (human_player_->field().HasShipsToReplace()) {
         return human_player_->field().removed_ship_size();
@@ -78,6 +96,7 @@ void Game::MoveShip(int x, int y, Orientation orientation) {
         show_ships_info_ = false;
         MoveAIShips();
         current_state_.set_game_status(GameStatus::PLAYER_TURN);
+        SpeculateAIMove();
     }
 }
 
@@ -85,66 +104,8 @@ void Game::MoveShip(int x, int y, Orientation orientation) {
 AttackResult Game::MakeAIMove() {
     AttackResult out{ -1, -1, -1 };
 
-    const PlayingField& human_field = human_player_->field();
-    const int W = human_field.x_size();
-    const int H = human_field.y_size();
-
-    // 1) цели для добивания: клетки, где сегмент в состоянии DamageD
-    std::vector<std::pair<int,int>> damaged_targets;
-
-    // 2) фронтир: UNKNOWN-соседи рядом с уже найденными сегментами
-    std::vector<std::pair<int,int>> frontier;
-
-    // 3) просто неизвестные клетки (fallback)
-    std::vector<std::pair<int,int>> unknown;
-
-    damaged_targets.reserve(W*H/8);
-    frontier.reserve(W*H/2);
-    unknown.reserve(W*H);
-
-    auto inb = [&](int x, int y){ return x>=0 && y>=0 && x<W && y<H; };
-
-    for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            const Cell& vis = human_field.visible_cell(x, y);
-
-            if (vis.IsShip()) {
-                // разрешено смотреть истинное состояние ТОЛЬКО по уже «открытым» клеткам
-                int ship_index, segment_index, ship_size;
-                SegmentState segment_state;
-                Orientation orient;
-                if (human_field.ship_info_at(x, y, ship_index, segment_index, ship_size, segment_state, orient)) {
-                    if (segment_state == SegmentState::DAMAGED) {
-                        damaged_targets.emplace_back(x, y); // приоритет №1 — добиваем
-                    }
-                }
-
-                // наращиваем фронтир вокруг любых найденных сегментов
-                if (inb(x+1,y) && human_field.visible_cell(x+1,y).IsUnknown()) frontier.emplace_back(x+1,y);
-                if (inb(x-1,y) && human_field.visible_cell(x-1,y).IsUnknown()) frontier.emplace_back(x-1,y);
-                if (inb(x,y+1) && human_field.visible_cell(x,y+1).IsUnknown()) frontier.emplace_back(x,y+1);
-                if (inb(x,y-1) && human_field.visible_cell(x,y-1).IsUnknown()) frontier.emplace_back(x,y-1);
-            } else if (vis.IsUnknown()) {
-                unknown.emplace_back(x, y);
-            }
-        }
-    }
-
-    // выбираем цель по приоритетам
     int tx = -1, ty = -1;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    if (!damaged_targets.empty()) {
-        std::uniform_int_distribution<> pick(0, static_cast<int>(damaged_targets.size()) - 1);
-        std::tie(tx, ty) = damaged_targets[pick(gen)];
-    } else if (!frontier.empty()) {
-        std::uniform_int_distribution<> pick(0, static_cast<int>(frontier.size()) - 1);
-        std::tie(tx, ty) = frontier[pick(gen)];
-    } else if (!unknown.empty()) {
-        std::uniform_int_distribution<> pick(0, static_cast<int>(unknown.size()) - 1);
-        std::tie(tx, ty) = unknown[pick(gen)];
-    } else {
+    if (!ai_planner_.Take(ai_observation_, current_state_.random().ai(), ai_revision_, tx, ty)) {
         // целей нет — всё открыто
         out.hit = -1; out.x = 0; out.y = 0;
         return out;
@@ -157,15 +118,19 @@ AttackResult Game::MakeAIMove() {
     out.x   = tx;
     out.y   = ty;
     out.hit = res;
+    ai_observation_.Record(tx, ty, res);
+    ++ai_revision_;
 
     UpdateTotalStats();
     UpdateScore();        
-    CheckWinCondition();
 
-    // передаём ход игроку только после валидного выстрела ИИ и если игра не завершилась
-    if (res >= 0 && current_state_.game_status() != GameStatus::PLAYER_WON &&
-        current_state_.game_status() != GameStatus::ENEMY_WON) {
+    // передаём ход игроку только после валидного выстрела ИИ и если раунд не завершился;
+    // EndRound уже перевёл игру в ожидание следующего раунда, и этот статус нельзя затирать
+    const bool round_over = human_player_->IsAllShipsDestroyed() || ai_player_->IsAllShipsDestroyed();
+    CheckWinCondition();
+    if (res >= 0 && !round_over) {
         current_state_.set_game_status(GameStatus::PLAYER_TURN);
+        SpeculateAIMove();
     }
 
     return out;
@@ -194,6 +159,8 @@ AbilityResult Game::UseAbility(int x, int y) {
     auto coordinates = human_player_->UseAbility(x, y);
     auto ability_name = ability_manager_->ability_name(); 
     if (coordinates.first != -1) {
+        // Способности получают и поле игрока, поэтому заранее посчитанный ход ИИ больше не верен.
+        ++ai_revision_;
         UpdateTotalStats();
         UpdateScore();
         current_state_.set_game_status(GameStatus::ENEMY_TURN);
@@ -310,26 +277,21 @@ std::string Game::statistics() const {
 
 std::vector<ShipDisplayInfo> Game::human_player_ships_info() const {
     std::vector<ShipDisplayInfo> result;
-    const PlayingField field = human_player_->field();
+    const PlayingField& field = human_player_->field();
+    result.reserve(ship_manager_->ship_count());
 
     for (int i = 0; i < ship_manager_->ship_count(); i++) {
         ShipDisplayInfo info;
         info.number = i + 1;
         
-        bool found = false;
-        for (int j = 0; j < field.count(); j++) {
-            try {
-                const Ship& ship = field.ship(j);
-                if (ship.ship_number() == i) { 
-                    info.is_placed = true;
-                    info.start_pos = ship.start_position();
-                    info.orientation = ship.orientation();
-                    info.size = ship.ship_size(); 
-                    found = true;
-                    break;
-                }
-            } catch (...) {
-            }
+        const int index = field.fleet().ship_index_by_number(i);
+        const bool found = index >= 0;
+        if (found) {
+            const Ship& ship = field.ship(index);
+            info.is_placed = true;
+            info.start_pos = ship.start_position();
+            info.orientation = ship.orientation();
+            info.size = ship.ship_size(); 
         }
         
         if (!found) {
@@ -368,8 +330,10 @@ void Game::set_players(std::unique_ptr<Player> human, std::unique_ptr<Player> ai
 
     ship_manager_ = human_player_->ship_manager();
 
-    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification());
+    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification(),
+                                                        current_state_.random().abilities());
     human_player_->set_ability_manager(ability_manager_); 
+    ResetAIObservation();
 
     current_state_.set_game_status(GameStatus::PLACING_SHIPS);
     current_state_.set_cursor(0, 0);
@@ -401,6 +365,7 @@ void Game::PauseGame() {
         current_state_.set_game_status(GameStatus::PAUSED);
     } else if (current_state_.game_status() == GameStatus::PAUSED) {
         current_state_.set_game_status(GameStatus::PLAYER_TURN);
+        SpeculateAIMove();
     }
 }
 
@@ -465,6 +430,7 @@ void Game::MoveCursorBy(int dx, int dy) {
 void Game::ClearFields(){
     ai_player_->field_for_modification().ClearField();
     human_player_->field_for_modification().ClearField();
+    ResetAIObservation();
 }
 
 std::string Game::game_help() const {
@@ -547,8 +513,10 @@ void Game::LoadStateFromLastRound() {
     human_player_->field_for_modification().ReturnStartState();
     ai_player_->field_for_modification().ReturnStartState();
 
-    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification());
+    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification(),
+                                                        current_state_.random().abilities());
     human_player_->set_ability_manager(ability_manager_);
+    ResetAIObservation();
 
     current_state_.set_game_status(GameStatus::SETTING_SHIPS);
 }
@@ -585,7 +553,9 @@ void Game::LoadGame(const std::string& filename) {
         current_state_.set_game_status(loaded_state.game_status());
         current_state_.set_round_number(loaded_state.round_number());
         current_state_.set_cursor(loaded_state.cursor_x(), loaded_state.cursor_y());
+        current_state_.set_random(loaded_state.random());
         LoadGameState();
+        SpeculateAIMove();
     } catch (const std::bad_alloc&) {
         throw std::runtime_error("Некорректный формат файла сохранения");
     }
@@ -604,7 +574,8 @@ void Game::LoadGameState() {
     ai_player_->field_for_modification()    = current_state_.enemy_field_state();
 
     
-    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification());
+    ability_manager_ = std::make_shared<AbilityManager>(ai_player_->field_for_modification(), human_player_->field_for_modification(),
+                                                        current_state_.random().abilities());
     human_player_->set_ability_manager(ability_manager_);
 
     {
@@ -624,6 +595,26 @@ void Game::LoadGameState() {
     ai_player_->set_destroyed_ships(current_state_.enemy_stats().destroyed);
     ai_player_->set_hit_count(current_state_.enemy_stats().hits);
     ai_player_->set_all_shots(current_state_.enemy_stats().shots);
+
+    ResetAIObservation();
+}
+
+
+void Game::ResetAIObservation() {
+    std::vector<int> fleet(ship_manager_->ship_count());
+    for (int i = 0; i < ship_manager_->ship_count(); ++i) {
+        fleet[i] = ship_manager_->ship_size(i);
+    }
+    ai_observation_ = AIObservation::FromVisibleField(human_player_->field(), fleet);
+    ++ai_revision_;
+}
+
+
+void Game::SpeculateAIMove() {
+    // Пока игрок целится, поле игрока не меняется, и ход ИИ можно считать заранее.
+    if (current_state_.game_status() == GameStatus::PLAYER_TURN) {
+        ai_planner_.Speculate(ai_observation_, current_state_.random().ai(), ai_revision_);
+    }
 }
 
 
@@ -641,6 +632,7 @@ GameStatus Game::game_status() const {
 
 void Game::set_player_turn_status() { 
     current_state_.set_game_status(GameStatus::PLAYER_TURN); 
+    SpeculateAIMove();
 }
 
 void Game::RotateShip() { 
@@ -682,6 +674,7 @@ bool Game::ShouldShowStats() const {
 
 void Game::set_game_status(GameStatus new_status) { 
     current_state_.set_game_status(new_status); 
+    SpeculateAIMove();
 }
 
 
@@ -717,6 +710,27 @@ void Game::set_temp_field_size(int size){
     settings_.set_temp_field_size(size);
 }
 
+
+void Game::ApplyAIDifficulty(){
+    settings_.ApplyAIDifficulty();
+    ai_planner_.Configure(settings_);
+}
+
+
+AIDifficulty Game::ai_difficulty() const {
+    return settings_.ai_difficulty();
+}
+
+
+void Game::set_temp_ai_difficulty(AIDifficulty difficulty){
+    settings_.set_temp_ai_difficulty(difficulty);
+}
+
+
+AIDifficulty Game::temp_ai_difficulty() const {
+    return settings_.temp_ai_difficulty();
+}
+
     
 std::string Game::fleet_spec_string(bool use_temp_fleet) const {
     std::vector<int> fleet_spec = use_temp_fleet ? settings_.temp_fleet_spec() : settings_.fleet_spec();
@@ -746,6 +760,11 @@ std::string Game::fleet_spec_string(bool use_temp_fleet) const {
 }
 
 
+FleetFit Game::temp_fleet_fit() const {
+    return settings_.temp_fleet_fit();
+}
+
+
 
 int Game::round_result() const {
     return current_state_.round_result();
@@ -11,9 +11,11 @@
 #include "abilities/AbilityManager.h"
 #include "core/ShipManager.h"
 #include "core/Player.h"
+#include "core/AIObservation.h"
 #include "additional/Other.h"
 #include "Result.h"
 #include "GameSettings.h"
+#include "AIMovePlanner.h"
 #include <map>
 
 class Player;
@@ -58,6 +60,8 @@ public:
     void AddShipSize(int size);
     void ClearShipSizes();
     void ApplyFieldSize();
+    // Сложность ИИ можно сменить во время расстановки: она действует со следующего хода ИИ.
+    void ApplyAIDifficulty();
 
     void UpdateScore();
     void CheckWinCondition();
@@ -111,19 +115,34 @@ public:
     void set_game_status(GameStatus newStat);
     void set_player_turn_status();
     std::pair<int, Orientation> current_ship_info() const;
+    PlacementStatus ship_placement_status(int x, int y) const;
     void set_temp_field_size(int size);    
     int temp_field_size() const;
+    AIDifficulty ai_difficulty() const;
+    void set_temp_ai_difficulty(AIDifficulty difficulty);
+    AIDifficulty temp_ai_difficulty() const;
     std::string statistics() const;
     std::vector<ShipDisplayInfo> human_player_ships_info() const;
     std::string fleet_spec_string(bool use_temp_fleet = false) const;
+    FleetFit temp_fleet_fit() const;
     void set_ship_fleet_spec();
     void set_auto_ship_sizes();
 
 private:
+    void ResetAIObservation();
+    void SpeculateAIMove();
+
     std::unique_ptr<Player> human_player_;
     std::unique_ptr<Player> ai_player_;
     std::shared_ptr<ShipManager> ship_manager_;
     std::shared_ptr<AbilityManager> ability_manager_;
+    // Поле игрока глазами ИИ: ходы ИИ выбираются только по нему.
+    AIObservation ai_observation_;
+    // Растёт при каждом изменении того, что видит ИИ; по ней планировщик узнаёт устаревший ход.
+    std::uint64_t ai_revision_ = 0;
+    AIMovePlanner ai_planner_;
+    // Автоматическая расстановка флота — и для игрока, и для ИИ.
+    UniformPlacement placement_strategy_;
     std::string human_name_;
     GameState current_state_;
     GameSettings settings_;
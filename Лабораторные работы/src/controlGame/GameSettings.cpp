@@ -135,7 +135,11 @@ void GameSettings::ConfigureGameSettings(){
         fleet_spec_ = parseFleetLine(line);
         if (fleet_spec_.size() > 16 || fleet_spec_.empty()) {
             std::cout << "Некорректный ввод. Применён стандартный набор.\n";
-            fleet_mode_ = FleetBuildMode::STANDARD;
+            set_fleet_mode();
+        } else if (FleetFeasibility::getInstance().Check(field_size_, field_size_, fleet_spec_) == FleetFit::DOES_NOT_FIT) {
+            std::cout << "Такой флот не помещается на поле " << field_size_ << "x" << field_size_
+                      << ". Применён стандартный набор.\n";
+            set_fleet_mode();
         }
     }
 
@@ -146,6 +150,15 @@ void GameSettings::ConfigureGameSettings(){
     int temp_pl_mode = readIntOrDefaultWithWarn(1, 1, 2);
     placement_mode_ = (temp_pl_mode == 2) ? PlacementMode::MANUAL : PlacementMode::AUTO;
 
+    std::cout << "\nСложность противника:\n"
+                 "1. Лёгкий\n"
+                 "2. Средний\n"
+                 "3. Сложный (думает дольше)\n"
+                 "Ваш выбор (1-3): ";
+    int temp_difficulty = readIntOrDefaultWithWarn(2, 1, 3);
+    ai_difficulty_ = (temp_difficulty == 1) ? AIDifficulty::EASY
+                   : (temp_difficulty == 3) ? AIDifficulty::HARD : AIDifficulty::MEDIUM;
+
     std::cout << "\nНастройки сохранены!\n";
 }
 
@@ -172,6 +185,11 @@ void GameSettings::ApplyFieldSize(){
 }
 
 
+void GameSettings::ApplyAIDifficulty(){
+    ai_difficulty_ = temp_ai_difficulty_;
+}
+
+
 void GameSettings::ResetFieldAndShipSize(){
     field_size_ = 10;
     set_fleet_mode();
@@ -208,6 +226,16 @@ void GameSettings::set_temp_field_size(int size){
 }
 
 
+AIDifficulty GameSettings::temp_ai_difficulty() const {
+    return temp_ai_difficulty_;
+}
+
+
+void GameSettings::set_temp_ai_difficulty(AIDifficulty difficulty){
+    temp_ai_difficulty_ = difficulty;
+}
+
+
 InterfaceType GameSettings::interface_type() const { 
     return interface_type_; 
 }
@@ -254,3 +282,69 @@ const std::vector<int>& GameSettings::fleet_spec() const {
 const std::vector<int>& GameSettings::temp_fleet_spec() const { 
     return temp_fleet_spec_; 
 }
+
+
+FleetFit GameSettings::temp_fleet_fit() const {
+    return FleetFeasibility::getInstance().Check(field_size_, field_size_, temp_fleet_spec_);
+}
+
+
+const LayoutPoolSettings& GameSettings::layout_pool_settings() const {
+    return layout_pool_settings_;
+}
+
+
+void GameSettings::set_layout_pool_settings(const LayoutPoolSettings& settings) {
+    layout_pool_settings_ = settings;
+}
+
+
+const std::optional<std::uint64_t>& GameSettings::seed() const {
+    return seed_;
+}
+
+
+void GameSettings::set_seed(std::optional<std::uint64_t> seed) {
+    seed_ = seed;
+}
+
+
+AIDifficulty GameSettings::ai_difficulty() const {
+    return ai_difficulty_;
+}
+
+
+void GameSettings::set_ai_difficulty(AIDifficulty difficulty) {
+    ai_difficulty_ = difficulty;
+}
+
+
+AIMoveBudget GameSettings::ai_move_budget() const {
+    using namespace std::chrono_literals;
+    switch (ai_difficulty_) {
+        case AIDifficulty::EASY:   return {0ms, 0};
+        case AIDifficulty::MEDIUM: return {50ms, 4000};
+        case AIDifficulty::HARD:   return {150ms, 40000};
+    }
+    return {0ms, 0};
+}
+
+
+const PosteriorSettings& GameSettings::posterior_settings() const {
+    return posterior_settings_;
+}
+
+
+void GameSettings::set_posterior_settings(const PosteriorSettings& settings) {
+    posterior_settings_ = settings;
+}
+
+
+const EndgameSettings& GameSettings::endgame_settings() const {
+    return endgame_settings_;
+}
+
+
+void GameSettings::set_endgame_settings(const EndgameSettings& settings) {
+    endgame_settings_ = settings;
+}
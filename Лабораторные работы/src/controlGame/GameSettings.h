@@ -1,7 +1,14 @@
 #ifndef BATTLESHIP_CONTROLGAME_GAMESETTINGS_H_
 #define BATTLESHIP_CONTROLGAME_GAMESETTINGS_H_
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
+#include "core/EndgameSolver.h"
+#include "core/FleetFeasibility.h"
+#include "core/LayoutPool.h"
+#include "core/PosteriorSampler.h"
 
 enum class InterfaceType { 
     CONSOLE, 
@@ -20,6 +27,22 @@ enum class PlacementMode {
 };
 
 
+enum class AIDifficulty {
+    EASY,
+    MEDIUM,
+    HARD
+};
+
+
+// Сколько ИИ может думать над одним ходом.
+struct AIMoveBudget {
+    // Время на ход; 0 — только быстрый ход по плотности позиций.
+    std::chrono::milliseconds time;
+    // Не больше стольких расстановок флота на ход.
+    int samples;
+};
+
+
 class GameSettings {
 public:    
     GameSettings();
@@ -29,11 +52,14 @@ public:
     void ClearTempFleetSpec();
     void ApplyFleetSpec();
     void ApplyFieldSize();
+    void ApplyAIDifficulty();
     void ResetFieldAndShipSize();
     
     void set_fleet_mode(bool custom = false);
     int temp_field_size() const;
     void set_temp_field_size(int size);
+    AIDifficulty temp_ai_difficulty() const;
+    void set_temp_ai_difficulty(AIDifficulty difficulty);
     
     InterfaceType interface_type() const;
 
@@ -50,6 +76,27 @@ public:
 
     const std::vector<int>& fleet_spec() const;
     const std::vector<int>& temp_fleet_spec() const;
+    FleetFit temp_fleet_fit() const;
+
+    const LayoutPoolSettings& layout_pool_settings() const;
+    void set_layout_pool_settings(const LayoutPoolSettings& settings);
+
+    // Зерно случайности партии; если не задано, у каждой партии своё.
+    const std::optional<std::uint64_t>& seed() const;
+    void set_seed(std::optional<std::uint64_t> seed);
+
+    // Сложность ИИ задаёт, сколько он думает над ходом. С заданным зерном время не ограничено,
+    // а ограничено только число расстановок, чтобы партия повторялась.
+    AIDifficulty ai_difficulty() const;
+    void set_ai_difficulty(AIDifficulty difficulty);
+    AIMoveBudget ai_move_budget() const;
+
+    const PosteriorSettings& posterior_settings() const;
+    void set_posterior_settings(const PosteriorSettings& settings);
+
+    // Когда ИИ переходит на точный перебор в конце раунда.
+    const EndgameSettings& endgame_settings() const;
+    void set_endgame_settings(const EndgameSettings& settings);
 
 private:
     InterfaceType interface_type_ = InterfaceType::GUI;
@@ -61,6 +108,12 @@ private:
     std::vector<int> fleet_spec_;
     std::vector<int> temp_fleet_spec_;
     int temp_field_size_ = 10;
+    LayoutPoolSettings layout_pool_settings_;
+    std::optional<std::uint64_t> seed_;
+    AIDifficulty ai_difficulty_ = AIDifficulty::MEDIUM;
+    AIDifficulty temp_ai_difficulty_ = AIDifficulty::MEDIUM;
+    PosteriorSettings posterior_settings_;
+    EndgameSettings endgame_settings_;
 };
 
 #endif
@@ -64,6 +64,7 @@ std::ostream& operator<<(std::ostream& os, const GameState& st) {
     os << st.player_field_state_;
     os << st.enemy_field_state_;
     os << st.player_abilities_;
+    os << st.random_;
 
     return os;
 }
@@ -87,6 +88,10 @@ std::istream& operator>>(std::istream& is, GameState& st) {
     st.enemy_field_state_ = PlayingField(ex, ey);
     is >> st.player_field_state_ >> st.enemy_field_state_;
     is >> st.player_abilities_;
+    // В старых сохранениях состояния генератора нет, тогда остаётся текущее.
+    if (is && !(is >> st.random_)) {
+        is.clear();
+    }
 
     return is;
 }
@@ -117,7 +122,7 @@ void GameState::LoadGame(const std::string& filename) {
 
 
 bool GameState::CanSave() const {
-    return status_ != GameStatus::ENEMY_TURN && status_ != GameStatus::ASK_SAVE && status_ != GameStatus::SET_FIELD && status_ != GameStatus::SET_SIZES && status_ != GameStatus::SELECT_LOAD_SLOT;
+    return status_ != GameStatus::ENEMY_TURN && status_ != GameStatus::ASK_SAVE && status_ != GameStatus::SET_FIELD && status_ != GameStatus::SET_SIZES && status_ != GameStatus::SET_DIFFICULTY && status_ != GameStatus::SELECT_LOAD_SLOT;
 }
 
 
@@ -227,6 +232,21 @@ const AbilityManager& GameState::player_abilities() const {
 }
 
 
+GameRandom& GameState::random() {
+    return random_;
+}
+
+
+const GameRandom& GameState::random() const {
+    return random_;
+}
+
+
+void GameState::set_random(const GameRandom& random) {
+    random_ = random;
+}
+
+
 int GameState::round_number() const { 
     return round_number_; 
 }
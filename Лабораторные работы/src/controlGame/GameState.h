@@ -8,6 +8,7 @@
 #include "core/PlayingField.h"
 #include "abilities/AbilityManager.h"
 #include "core/ShipManager.h"
+#include "core/Random.h"
 #include <fstream>
 
 struct PlayerStats {
@@ -50,7 +51,8 @@ enum class GameStatus {
     ASK_SAVE,               // Prompting for save confirmation
     WAITING_NEXT_ROUND,     // Waiting to start next round
     SELECT_SAVE_SLOT,       // Choosing save file slot
-    SELECT_LOAD_SLOT        // Choosing load file slot
+    SELECT_LOAD_SLOT,       // Choosing load file slot
+    SET_DIFFICULTY          // Choosing AI difficulty
 };
 
 class GameState {
@@ -85,6 +87,10 @@ public:
 
     const AbilityManager& player_abilities()  const;
 
+    GameRandom& random();
+    const GameRandom& random() const;
+    void set_random(const GameRandom& random);
+
     int round_number() const;
     void set_round_number(int round);
     
@@ -139,7 +145,9 @@ private:
     PlayingField player_field_state_{10, 10};
     PlayingField enemy_field_state_{10, 10};
     
-    AbilityManager player_abilities_{enemy_field_state_, player_field_state_};
+    // Объявлен до player_abilities_: способности берут числа из его потока уже в конструкторе.
+    GameRandom random_;
+    AbilityManager player_abilities_{enemy_field_state_, player_field_state_, random_.abilities()};
     ShipManager ship_manager_; 
 };
 
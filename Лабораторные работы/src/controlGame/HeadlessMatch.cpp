@@ -0,0 +1,108 @@
+#include "HeadlessMatch.h"
+#include <memory>
+#include <string>
+#include "abilities/AbilityException.h"
+#include "abilities/AbilityManager.h"
+#include "additional/ShipCoordinateExceptions.h"
+#include "core/AIObservation.h"
+#include "core/Player.h"
+#include "core/ShipManager.h"
+
+
+
+HeadlessMatch::HeadlessMatch(const MatchSettings& settings, const PlacementStrategy& placement)
+        : settings_(settings), placement_(placement) {}
+
+
+MatchResult HeadlessMatch::Play(std::array<TargetingStrategy*, 2> strategies, int first,
+                                std::array<std::uint64_t, 2> seeds) const {
+    const int size = settings_.field_size;
+    auto ship_manager = std::make_shared<ShipManager>(static_cast<int>(settings_.fleet.size()), settings_.fleet);
+    std::array<GameRandom, 2> random = {GameRandom(seeds[0]), GameRandom(seeds[1])};
+
+    std::array<std::unique_ptr<Player>, 2> players;
+    for (int side = 0; side < 2; ++side) {
+        players[side] = std::make_unique<Player>("ИИ " + std::to_string(side + 1), PlayerType::AI,
+                                                 ship_manager, size, size);
+        if (!players[side]->PlaceShipsRandomly(random[side].placement(), placement_)) {
+            throw ImpossibleFleetException();
+        }
+    }
+
+    // Менеджер стороны стреляет по полю противника и берёт случайность из потока способностей стороны.
+    std::array<std::shared_ptr<AbilityManager>, 2> ability_managers;
+    if (settings_.abilities) {
+        for (int side = 0; side < 2; ++side) {
+            ability_managers[side] = std::make_shared<AbilityManager>(
+                players[1 - side]->field_for_modification(), players[side]->field_for_modification(),
+                random[side].abilities());
+            players[side]->set_ability_manager(ability_managers[side]);
+        }
+    }
+
+    std::array<AIObservation, 2> observations = {AIObservation(size, size, settings_.fleet),
+                                                  AIObservation(size, size, settings_.fleet)};
+    MatchResult result;
+    const int max_turns = MaxTurns();
+    for (int side = first; result.turns < max_turns; side = 1 - side) {
+        const int enemy = 1 - side;
+        int x = -1, y = -1;
+        if (!strategies[side]->ChooseTarget(observations[side], random[side].ai(), x, y)) {
+            break;
+        }
+        ++result.turns;
+
+        if (ability_managers[side] && ability_managers[side]->HasAbilities()) {
+            try {
+                players[side]->UseAbility(x, y);
+                result.sides[side].abilities_used++;
+                for (const AbilityOutcome& outcome : ability_managers[side]->last_outcomes()) {
+                    if (outcome.damage == 0) {
+                        observations[side].RecordScan(outcome.x, outcome.y, outcome.result != 0);
+                    } else {
+                        observations[side].Record(outcome.x, outcome.y, outcome.result, outcome.damage);
+                    }
+                }
+            } catch (const AbilityException&) {
+                // Способность не сработала (обстрелу не по кому стрелять), но ход потрачен.
+            }
+        } else {
+            const int hit = players[side]->MakeMove(players[enemy], x, y);
+            observations[side].Record(x, y, hit);
+            // Player даёт способность за потопленный корабль только человеку, а здесь её получают обе стороны.
+            if (hit == 2 && ability_managers[side]) {
+                ability_managers[side]->AddNextAbility();
+            }
+        }
+
+        if (players[enemy]->field().IsAllShipsDestroyed()) {
+            result.winner = side;
+            break;
+        }
+    }
+
+    // Корабли, потопленные способностями, Player не считает, поэтому потери берутся с поля.
+    for (int side = 0; side < 2; ++side) {
+        MatchSideStats& stats = result.sides[side];
+        stats.shots = players[side]->all_shots();
+        stats.hits = players[side]->hit_count();
+        stats.ships_destroyed = static_cast<int>(settings_.fleet.size()) -
+                                players[1 - side]->field().fleet().alive_ships();
+    }
+    return result;
+}
+
+
+const MatchSettings& HeadlessMatch::settings() const {
+    return settings_;
+}
+
+
+int HeadlessMatch::MaxTurns() const {
+    if (settings_.max_turns > 0) {
+        return settings_.max_turns;
+    }
+    // Каждой стороне хватит двух выстрелов в каждую клетку и всех способностей, какие у неё могут быть.
+    const int cells = settings_.field_size * settings_.field_size;
+    return 2 * (2 * cells + 3 + static_cast<int>(settings_.fleet.size()));
+}
@@ -0,0 +1,62 @@
+#ifndef BATTLESHIP_CONTROLGAME_HEADLESSMATCH_H_
+#define BATTLESHIP_CONTROLGAME_HEADLESSMATCH_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "core/PlacementStrategy.h"
+#include "core/TargetingStrategy.h"
+
+struct MatchSettings {
+    int field_size = 10;
+    std::vector<int> fleet = {4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+    // Есть ли у сторон способности: три в начале и по одной за каждый потопленный корабль.
+    bool abilities = true;
+    // Ходов на партию, после которых она считается ничьей; 0 — по размеру поля.
+    int max_turns = 0;
+};
+
+
+struct MatchSideStats {
+    int shots = 0;
+    int hits = 0;
+    int ships_destroyed = 0;
+    int abilities_used = 0;
+};
+
+
+struct MatchResult {
+    // Номер победившей стороны; -1 — ничья.
+    int winner = -1;
+    int turns = 0;
+    std::array<MatchSideStats, 2> sides{};
+};
+
+
+// Одна партия ИИ против ИИ без ввода-вывода.
+//
+// Партия идёт по тем же правилам, что и Game, и через те же Player, PlayingField и AbilityManager:
+// стороны расставляют флот, затем ходят по очереди, и ход — это либо выстрел в один урон, либо
+// способность, после которой ход тоже переходит. Сторона применяет способность, как только она
+// есть, в клетку, которую выбрала стратегия стрельбы; то, что способность открыла, попадает
+// в наблюдение стороны. Побеждает тот, кто первым потопил весь флот противника.
+// Каждая сторона получает свою GameRandom: расстановка, стрельба и способности не делят поток.
+class HeadlessMatch {
+public:
+    HeadlessMatch(const MatchSettings& settings, const PlacementStrategy& placement);
+
+    // Сыграть партию. first — номер стороны, которая ходит первой; seeds — зёрна сторон.
+    // Бросает ImpossibleFleetException, если флот не помещается на поле.
+    MatchResult Play(std::array<TargetingStrategy*, 2> strategies, int first,
+                     std::array<std::uint64_t, 2> seeds) const;
+
+    const MatchSettings& settings() const;
+
+private:
+    int MaxTurns() const;
+
+    MatchSettings settings_;
+    const PlacementStrategy& placement_;
+};
+
+#endif
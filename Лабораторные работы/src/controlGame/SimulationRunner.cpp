@@ -0,0 +1,122 @@
+#include "SimulationRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+double SimulationReport::games_per_second() const {
+    return seconds > 0.0 ? static_cast<double>(matches) / seconds : 0.0;
+}
+
+
+SimulationRunner::SimulationRunner(const SimulationSettings& settings, std::array<StrategyFactory, 2> factories)
+        : settings_(settings), factories_(std::move(factories)) {}
+
+
+SimulationReport SimulationRunner::Run() const {
+    const int threads = settings_.threads > 0
+        ? settings_.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    const long long tasks = (settings_.matches + kMatchesPerTask - 1) / kMatchesPerTask;
+    std::vector<SimulationReport> partial(static_cast<std::size_t>(tasks));
+    std::atomic<long long> next_task{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&] {
+        try {
+            const UniformPlacement placement(false);
+            const HeadlessMatch match(settings_.match, placement);
+            const std::unique_ptr<TargetingStrategy> first = factories_[0]();
+            const std::unique_ptr<TargetingStrategy> second = factories_[1]();
+            for (long long task = next_task++; task < tasks && !failed; task = next_task++) {
+                const long long begin = task * kMatchesPerTask;
+                const long long end = std::min(settings_.matches, begin + kMatchesPerTask);
+                PlayMatches(match, {first.get(), second.get()}, begin, end, partial[task]);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    SimulationReport report;
+    report.threads = threads;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const SimulationReport& part : partial) {
+        report.matches += part.matches;
+        report.draws += part.draws;
+        report.turns += part.turns;
+        report.first_mover_wins += part.first_mover_wins;
+        for (int s = 0; s < 2; ++s) {
+            StrategyTotals& total = report.strategies[s];
+            const StrategyTotals& add = part.strategies[s];
+            total.wins += add.wins;
+            total.shots += add.shots;
+            total.hits += add.hits;
+            total.ships_destroyed += add.ships_destroyed;
+            total.abilities_used += add.abilities_used;
+            total.shots_to_win += add.shots_to_win;
+            total.shots_to_win_sq += add.shots_to_win_sq;
+        }
+    }
+    return report;
+}
+
+
+const SimulationSettings& SimulationRunner::settings() const {
+    return settings_;
+}
+
+
+void SimulationRunner::PlayMatches(const HeadlessMatch& match, std::array<TargetingStrategy*, 2> strategies,
+                                   long long begin, long long end, SimulationReport& report) const {
+    for (long long m = begin; m < end; ++m) {
+        Rng seeds(settings_.seed ^ (static_cast<std::uint64_t>(m) * 0x9E3779B97F4A7C15ull));
+        const std::uint64_t seed_first = seeds();
+        const std::uint64_t seed_second = seeds();
+        const int first_side = static_cast<int>(m % 2);
+        const MatchResult result = match.Play(strategies, first_side, {seed_first, seed_second});
+
+        report.matches++;
+        report.turns += result.turns;
+        if (result.winner < 0) {
+            report.draws++;
+        } else if (result.winner == first_side) {
+            report.first_mover_wins++;
+        }
+        for (int s = 0; s < 2; ++s) {
+            StrategyTotals& totals = report.strategies[s];
+            const MatchSideStats& side = result.sides[s];
+            totals.shots += side.shots;
+            totals.hits += side.hits;
+            totals.ships_destroyed += side.ships_destroyed;
+            totals.abilities_used += side.abilities_used;
+            if (result.winner == s) {
+                totals.wins++;
+                totals.shots_to_win += side.shots;
+                totals.shots_to_win_sq += static_cast<double>(side.shots) * side.shots;
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef BATTLESHIP_CONTROLGAME_SIMULATIONRUNNER_H_
+#define BATTLESHIP_CONTROLGAME_SIMULATIONRUNNER_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "HeadlessMatch.h"
+#include "core/TargetingStrategy.h"
+
+struct SimulationSettings {
+    MatchSettings match;
+    long long matches = 10000;
+    // Сколько потоков играет партии; 0 — по числу ядер.
+    int threads = 0;
+    std::uint64_t seed = 1;
+};
+
+
+// Сумма по партиям для одной стратегии.
+struct StrategyTotals {
+    long long wins = 0;
+    long long shots = 0;
+    long long hits = 0;
+    long long ships_destroyed = 0;
+    long long abilities_used = 0;
+    // Выстрелы в выигранных партиях и их квадраты — для среднего и его разброса.
+    long long shots_to_win = 0;
+    double shots_to_win_sq = 0.0;
+};
+
+
+struct SimulationReport {
+    long long matches = 0;
+    long long draws = 0;
+    long long turns = 0;
+    // Победы той стратегии, что ходила первой.
+    long long first_mover_wins = 0;
+    std::array<StrategyTotals, 2> strategies{};
+    int threads = 0;
+    double seconds = 0.0;
+
+    double games_per_second() const;
+};
+
+
+// Пакет партий HeadlessMatch двух стратегий на пуле потоков.
+//
+// Партии раздаются потокам кусками по kMatchesPerTask: поток, закончивший свой кусок, берёт
+// следующий, поэтому медленные партии не держат остальные потоки. Зёрна сторон партии m
+// выводятся из зерна пакета и номера m, первой ходит стратегия 0 в чётных партиях и
+// стратегия 1 в нечётных. Итоги кусков складываются по порядку кусков, поэтому при том же
+// зерне отчёт повторяется при любом числе потоков. Стратегии создаются фабриками заново
+// в каждом потоке.
+class SimulationRunner {
+public:
+    using StrategyFactory = std::function<std::unique_ptr<TargetingStrategy>()>;
+
+    SimulationRunner(const SimulationSettings& settings, std::array<StrategyFactory, 2> factories);
+
+    // Бросает ImpossibleFleetException, если флот не помещается на поле.
+    SimulationReport Run() const;
+
+    const SimulationSettings& settings() const;
+
+private:
+    // Столько партий подряд берёт поток за раз.
+    static constexpr int kMatchesPerTask = 16;
+
+    void PlayMatches(const HeadlessMatch& match, std::array<TargetingStrategy*, 2> strategies,
+                     long long begin, long long end, SimulationReport& report) const;
+
+    SimulationSettings settings_;
+    std::array<StrategyFactory, 2> factories_;
+};
+
+#endif
@@ -14,6 +14,7 @@ enum class CommandType {
     SET_NEW_FIELD,
     SET_NEW_SHIP_SIZES,
     TOGGLE_PLACEMENT_MODE,
+    SET_DIFFICULTY,
     SHOW_SHIPS,
     HELP,
     STATS,
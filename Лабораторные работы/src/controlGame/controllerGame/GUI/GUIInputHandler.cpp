@@ -262,6 +262,7 @@ void GUIInputHandler::SetDefaultBindings() {
     key_bindings_[sf::Keyboard::Escape]  = CommandType::PAUSE;
     key_bindings_[sf::Keyboard::E]       = CommandType::SET_NEW_FIELD;
     key_bindings_[sf::Keyboard::Z]       = CommandType::SET_NEW_SHIP_SIZES;
+    key_bindings_[sf::Keyboard::K]       = CommandType::SET_DIFFICULTY;
     key_bindings_[sf::Keyboard::Num1]    = CommandType::SET_1;
     key_bindings_[sf::Keyboard::Num2]    = CommandType::SET_2;
     key_bindings_[sf::Keyboard::Num3]    = CommandType::SET_3;
@@ -358,6 +359,7 @@ bool GUIInputHandler::ValidateOrFixBindings() {
         {CommandType::PAUSE,               sf::Keyboard::Escape},
         {CommandType::SET_NEW_FIELD,       sf::Keyboard::E},
         {CommandType::SET_NEW_SHIP_SIZES,  sf::Keyboard::Z},
+        {CommandType::SET_DIFFICULTY,      sf::Keyboard::K},
         {CommandType::YES,                 sf::Keyboard::Y},
         {CommandType::NO,                  sf::Keyboard::N},
         {CommandType::SET_1,               sf::Keyboard::Num1},
@@ -419,6 +421,7 @@ CommandType GUIInputHandler::ParseCommand(const std::string& command_str) const
     if (command_str == "SET_NEW_FIELD")              return CommandType::SET_NEW_FIELD;
     if (command_str == "SET_NEW_SHIP_SIZES")         return CommandType::SET_NEW_SHIP_SIZES;
     if (command_str == "TOGGLE_PLACEMENT_MODE")      return CommandType::TOGGLE_PLACEMENT_MODE;
+    if (command_str == "SET_DIFFICULTY")             return CommandType::SET_DIFFICULTY;
     if (command_str == "SET_1")                      return CommandType::SET_1;
     if (command_str == "SET_2")                      return CommandType::SET_2;
     if (command_str == "SET_3")                      return CommandType::SET_3;
@@ -453,6 +456,7 @@ std::string GUIInputHandler::CommandToString(CommandType command) const {
         case CommandType::SET_NEW_FIELD:        return "SET_NEW_FIELD";
         case CommandType::SET_NEW_SHIP_SIZES:   return "SET_NEW_SHIP_SIZES";
         case CommandType::TOGGLE_PLACEMENT_MODE:    return "TOGGLE_PLACEMENT_MODE";
+        case CommandType::SET_DIFFICULTY:       return "SET_DIFFICULTY";
         case CommandType::SET_1: return "SET_1";
         case CommandType::SET_2: return "SET_2";
         case CommandType::SET_3: return "SET_3";
@@ -633,7 +637,7 @@ const std::string GUIInputHandler::control_legend() {
     std::string move_key = (movement_scheme_ == MovementScheme::WASD) ? "WASD" : "СТРЕЛКИ";
     std::string attack_key, ability_key, save_key, load_key, pause_key, place_ship_key, rotate_key,
                 remove_key, show_ships_key, restart_key, help_key, stats_key,
-                field_key, ship_size_key, toggle_placement_key, exit_key, yes_key, no_key,
+                field_key, ship_size_key, toggle_placement_key, difficulty_key, exit_key, yes_key, no_key,
                 set_1_key, set_2_key, set_3_key, set_4_key, set_5_key;
 
     for (const auto& [key, command] : key_bindings_) {
@@ -655,6 +659,7 @@ const std::string GUIInputHandler::control_legend() {
             case CommandType::SET_NEW_FIELD:        field_key = keyName; break;
             case CommandType::SET_NEW_SHIP_SIZES:   ship_size_key = keyName; break;
             case CommandType::TOGGLE_PLACEMENT_MODE:toggle_placement_key = keyName; break;
+            case CommandType::SET_DIFFICULTY:       difficulty_key = keyName; break;
             case CommandType::EXIT:                 exit_key = keyName; break;
             case CommandType::YES:                  yes_key = keyName; break;
             case CommandType::NO:                   no_key = keyName; break;
@@ -682,6 +687,7 @@ const std::string GUIInputHandler::control_legend() {
     if (field_key.empty())           field_key = "E";
     if (ship_size_key.empty())       ship_size_key = "Z";
     if (toggle_placement_key.empty())toggle_placement_key = "A";
+    if (difficulty_key.empty())      difficulty_key = "K";
     if (exit_key.empty())            exit_key = "Q";
     if (yes_key.empty())             yes_key = "Y";
     if (no_key.empty())              no_key = "N";
@@ -695,7 +701,7 @@ const std::string GUIInputHandler::control_legend() {
            " КОРАБЛИ: [" + place_ship_key + "] - разместить | [" + rotate_key + "] - повернуть | [" + remove_key + "] - удалить | ["
            + show_ships_key + "] - показать\n"
            " ДОП: [" + field_key + "] - изменить поле | [" + ship_size_key + "] - изменить корабли | [" + toggle_placement_key
-           + "] - переключить режим расстановки\n"
+           + "] - переключить режим расстановки | [" + difficulty_key + "] - сложность ИИ\n"
            " ВЫБОР: [" + set_1_key + "] - выб_1 | [" + set_2_key + "] - выб_2 | [" + set_3_key + "] - выб_3 | [" + set_4_key
            + "] - выб_4 | [" + set_5_key + "] - выб_5 | [" + yes_key + "]/[" + no_key + "] - ДА/НЕТ\n"
            " СИСТЕМА: [" + save_key + "]/[" + load_key + "] - сохр/загр | [" + pause_key + "] - пауза | ["
@@ -73,6 +73,7 @@ void GUIRenderer::Render(const Game& game, const std::string& controls_legend){
     RenderStats(game);
     RenderFieldSizeSelection(game);
     RenderShipSizeSelection(game);
+    RenderDifficultySelection(game);
     RenderAskRound(game);
     RenderSettingships_(game);
     RenderAskSave(game);
@@ -761,6 +762,89 @@ void GUIRenderer::RenderFieldSizeSelection(const Game& game) {
     window_.draw(hint);
 }
 
+void GUIRenderer::RenderDifficultySelection(const Game& game) {
+    if (game.game_status() != GameStatus::SET_DIFFICULTY) return;
+    // Окно того же размера, что и выбор размера поля: на экране они не бывают одновременно.
+    const float x = (window_.getSize().x - field_select_width_) / 2.f;
+    const float y = (window_.getSize().y - field_select_height_) / 2.f;
+    const float padding = 30.f;
+
+    sf::VertexArray gradient(sf::Quads, 4);
+    sf::Color topColor(60, 30, 20);
+    sf::Color bottomColor(100, 55, 35);
+    gradient[0].position = sf::Vector2f(x, y);
+    gradient[1].position = sf::Vector2f(x + field_select_width_, y);
+    gradient[2].position = sf::Vector2f(x + field_select_width_, y + field_select_height_);
+    gradient[3].position = sf::Vector2f(x, y + field_select_height_);
+    gradient[0].color = topColor;
+    gradient[1].color = topColor;
+    gradient[2].color = bottomColor;
+    gradient[3].color = bottomColor;
+    window_.draw(gradient);
+
+    sf::RectangleShape frame(sf::Vector2f(field_select_width_, field_select_height_));
+    frame.setPosition(x, y);
+    frame.setFillColor(sf::Color::Transparent);
+    frame.setOutlineThickness(3.f);
+    frame.setOutlineColor(sf::Color(230, 160, 110, 200));
+    window_.draw(frame);
+
+    sf::Text title;
+    title.setFont(font_);
+    title.setCharacterSize(24);
+    title.setStyle(sf::Text::Bold);
+    title.setFillColor(sf::Color(255, 215, 180));
+    title.setString(utf8(u8"СЛОЖНОСТЬ ПРОТИВНИКА"));
+    title.setPosition(x + field_select_width_ / 2.f - 150.f, y + 20.f);
+    window_.draw(title);
+
+    sf::Text message;
+    message.setFont(font_);
+    message.setCharacterSize(18);
+    message.setFillColor(sf::Color(255, 225, 200));
+    message.setString(utf8(u8"Сколько ИИ думает над ходом:"));
+    message.setPosition(x + padding, y + 60.f);
+    window_.draw(message);
+
+    const std::vector<std::string> options = {
+        u8"выб_1 - Лёгкий: сразу, по плотности позиций",
+        u8"выб_2 - Средний: до 50 мс на ход",
+        u8"выб_3 - Сложный: до 150 мс на ход",
+    };
+
+    float option_y = y + 95.f;
+    for (const auto& option : options) {
+        sf::Text option_text;
+        option_text.setFont(font_);
+        option_text.setCharacterSize(17);
+        option_text.setFillColor(sf::Color(245, 215, 195));
+        option_text.setString(utf8(option));
+        option_text.setPosition(x + padding, option_y);
+        window_.draw(option_text);
+        option_y += 28.f;
+    }
+
+    const AIDifficulty selected = game.temp_ai_difficulty();
+    const char* selected_name = selected == AIDifficulty::EASY ? u8"Лёгкий"
+                              : selected == AIDifficulty::HARD ? u8"Сложный" : u8"Средний";
+    sf::Text selected_text;
+    selected_text.setFont(font_);
+    selected_text.setCharacterSize(17);
+    selected_text.setFillColor(sf::Color(190, 240, 220));
+    selected_text.setStyle(sf::Text::Bold);
+    selected_text.setString(utf8(std::string(u8"Выбранная сложность: ") + selected_name));
+    selected_text.setPosition(x + padding, option_y + 10.f);
+    window_.draw(selected_text);
+
+    sf::Text hint;
+    hint.setFont(font_);
+    hint.setCharacterSize(17);
+    hint.setFillColor(sf::Color(230, 200, 180));
+    hint.setString(utf8(u8"ДА - сохранить сложность, НЕТ - отмена"));
+    hint.setPosition(x + padding, y + field_select_height_ - 40.f);
+    window_.draw(hint);
+}
+
 void GUIRenderer::RenderShipSizeSelection(const Game& game) {
     if (game.game_status() != GameStatus::SET_SIZES) return;
     ship_sizes_x_ = (window_.getSize().x - ship_sizes_width_) / 2.f;
@@ -840,6 +924,26 @@ void GUIRenderer::RenderShipSizeSelection(const Game& game) {
     current_temp_fleet.setString(utf8(game.fleet_spec_string(true)));
     current_temp_fleet.setPosition(ship_sizes_x_ + padding, option_y + 35.f);
     window_.draw(current_temp_fleet);
+
+    sf::Text fleet_fit;
+    fleet_fit.setFont(font_);
+    fleet_fit.setCharacterSize(15);
+    switch (game.temp_fleet_fit()) {
+        case FleetFit::FITS:
+            fleet_fit.setFillColor(sf::Color(140, 230, 140));
+            fleet_fit.setString(utf8(u8"Помещается на поле"));
+            break;
+        case FleetFit::DOES_NOT_FIT:
+            fleet_fit.setFillColor(sf::Color(255, 120, 120));
+            fleet_fit.setString(utf8(u8"Не помещается на поле"));
+            break;
+        case FleetFit::UNKNOWN:
+            fleet_fit.setFillColor(sf::Color(240, 210, 120));
+            fleet_fit.setString(utf8(u8"Не удалось проверить, помещается ли флот"));
+            break;
+    }
+    fleet_fit.setPosition(ship_sizes_x_ + padding, option_y + 60.f);
+    window_.draw(fleet_fit);
    
     sf::Text current_fleet_title;
     current_fleet_title.setFont(font_);
@@ -847,7 +951,7 @@ void GUIRenderer::RenderShipSizeSelection(const Game& game) {
     current_fleet_title.setStyle(sf::Text::Bold);
     current_fleet_title.setFillColor(sf::Color(190, 240, 220));
     current_fleet_title.setString(utf8(u8"Текущий флот:"));
-    current_fleet_title.setPosition(ship_sizes_x_ + padding, option_y + 75.f);
+    current_fleet_title.setPosition(ship_sizes_x_ + padding, option_y + 100.f);
     window_.draw(current_fleet_title);
     
     sf::Text current_fleet;
@@ -855,7 +959,7 @@ void GUIRenderer::RenderShipSizeSelection(const Game& game) {
     current_fleet.setCharacterSize(17);
     current_fleet.setFillColor(sf::Color(200, 255, 230));
     current_fleet.setString(utf8(game.fleet_spec_string()));
-    current_fleet.setPosition(ship_sizes_x_ + padding, option_y + 100.f);
+    current_fleet.setPosition(ship_sizes_x_ + padding, option_y + 125.f);
     window_.draw(current_fleet);
     
     sf::Text hint;
@@ -1177,7 +1281,7 @@ void GUIRenderer::RenderField(const PlayingField&  field, const std::string& tit
             water.setTexture(water_texture_);
             water.setPosition(pos);
             window_.draw(water);
-            const Cell& vis = field.visible_cell(x, y);
+            const Cell vis = field.visible_cell(x, y);
             if (is_enemy_field) {
                 if (field.IsScanned(x, y)) {
                     bool has_segment = field.IsShipCell(x, y);
@@ -1272,10 +1376,11 @@ void GUIRenderer::RenderCursor(const Game& game) {
    
     sf::Vector2f cursor_pos;
     if (game.game_status() == GameStatus::PLACING_SHIPS || game.game_status() == GameStatus::SET_FIELD 
-        || game.game_status() == GameStatus::SET_SIZES ) {
+        || game.game_status() == GameStatus::SET_SIZES || game.game_status() == GameStatus::SET_DIFFICULTY) {
         cursor_pos = sf::Vector2f(player_pos_.x + cx * cell_spacing_, player_pos_.y + cy * cell_spacing_ + 30.f);
     
-        if (!error_message_.empty() && game.placement_mode() == PlacementMode::MANUAL) {
+        if (game.game_status() == GameStatus::PLACING_SHIPS && game.placement_mode() == PlacementMode::MANUAL &&
+            game.CanPlaceShip() && game.ship_placement_status(cx, cy) != PlacementStatus::OK) {
             RenderErrorShip(game, cx, cy);
             return ;
         }
@@ -1312,6 +1417,8 @@ void GUIRenderer::RenderGameStatus(const Game& game) {
             break;
         case GameStatus::SET_SIZES: text = u8"Настройка флота"; color = sf::Color(173, 216, 230);
             break;
+        case GameStatus::SET_DIFFICULTY: text = u8"Настройка сложности ИИ"; color = sf::Color(255, 200, 150);
+            break;
         case GameStatus::ASK_SAVE: text = u8"Сохранение игры"; color = sf::Color(255, 69, 0);
             break;
         case GameStatus::SETTING_SHIPS: text = u8"Изменение кораблей"; color = sf::Color(210, 180, 140);
@@ -1339,7 +1446,7 @@ void GUIRenderer::RenderGameStatus(const Game& game) {
 
 void GUIRenderer::RenderErrorShip(const Game& game, int start_x, int start_y) {
     auto [ship_size, orientation] = game.current_ship_info();
-    const auto player_field = game.player_field();
+    const PlayingField& player_field = game.player_field();
     const sf::Vector2f& origin = player_pos_;
         
     for (int i = 0; i < ship_size; ++i) {
@@ -115,7 +115,7 @@ private:
     float field_select_y_;
 
     const float ship_sizes_width_ = 480.f;
-    const float ship_sizes_height_ = 415.f;
+    const float ship_sizes_height_ = 440.f;
     float ship_sizes_x_;
     float ship_sizes_y_;
 
@@ -157,6 +157,7 @@ private:
     void RenderControlsLegend(const std::string& legend);
     void RenderFieldSizeSelection(const Game& game);
     void RenderShipSizeSelection(const Game& game);
+    void RenderDifficultySelection(const Game& game);
     void RenderAskRound(const Game& game);
     void RenderSettingships_(const Game& game);
     void RenderAskSave(const Game& game);
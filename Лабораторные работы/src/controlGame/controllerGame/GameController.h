@@ -92,8 +92,11 @@ private:
         using namespace std::chrono_literals;
         renderer_->ShowShotBanner( game_.ai_name() + " стреляет...", false);
         renderer_->Render(game_, input_handler_->control_legend());
-        std::this_thread::sleep_for(16ms);
-        renderer_->OnAttackResult(game_.MakeAIMove(), false);
+        // Пока висит надпись, ИИ думает над ходом; надпись видна не меньше прежних 16 мс.
+        const auto started = std::chrono::steady_clock::now();
+        AttackResult result = game_.MakeAIMove();
+        std::this_thread::sleep_until(started + 16ms);
+        renderer_->OnAttackResult(result, false);
         std::this_thread::sleep_for(150ms);
     }
 
@@ -115,6 +118,7 @@ private:
             case CommandType::HELP:
                 return status != GameStatus::SELECT_SAVE_SLOT && status != GameStatus::SELECT_LOAD_SLOT &&
                         status != GameStatus::SET_SIZES && status != GameStatus::SET_FIELD &&
+                        status != GameStatus::SET_DIFFICULTY &&
                         status != GameStatus::ASK_EXIT && status != GameStatus::ASK_SAVE; 
             case CommandType::PAUSE:       return status == GameStatus::PLAYER_TURN || status == GameStatus::PAUSED;
             case CommandType::RESTART:     return status == GameStatus::PLAYER_WON || status == GameStatus::ENEMY_WON || status == GameStatus::GAME_OVER || status == GameStatus::PAUSED;
@@ -125,6 +129,7 @@ private:
             case CommandType::ATTACK:      return status == GameStatus::PLAYER_TURN;
             case CommandType::SET_NEW_SHIP_SIZES: 
             case CommandType::SET_NEW_FIELD: 
+            case CommandType::SET_DIFFICULTY:
             case CommandType::TOGGLE_PLACEMENT_MODE:
                 return status == GameStatus::PLACING_SHIPS;
             case CommandType::SHOW_SHIPS:  return status == GameStatus::PLACING_SHIPS  && game_.placement_mode() == PlacementMode::MANUAL;
@@ -142,13 +147,15 @@ private:
             case CommandType::SET_4:
             case CommandType::SET_5:
                 return status == GameStatus::SET_FIELD || status == GameStatus::SET_SIZES ||
+                        status == GameStatus::SET_DIFFICULTY ||
                         status == GameStatus::SELECT_SAVE_SLOT || status == GameStatus::SELECT_LOAD_SLOT;
             case CommandType::YES:
             case CommandType::NO:
                 return status == GameStatus::ASK_SAVE || status == GameStatus::SETTING_SHIPS 
                         || status == GameStatus::ASK_EXIT || status == GameStatus::WAITING_NEXT_ROUND ||
                         status == GameStatus::SELECT_LOAD_SLOT || status == GameStatus::SELECT_SAVE_SLOT ||
-                        status == GameStatus::SET_FIELD || status == GameStatus::SET_SIZES;
+                        status == GameStatus::SET_FIELD || status == GameStatus::SET_SIZES ||
+                        status == GameStatus::SET_DIFFICULTY;
                             
             default:
                 return false;
@@ -204,6 +211,13 @@ private:
                         game_.set_game_status(GameStatus::SET_FIELD);
                     } 
                     break;
+                case CommandType::SET_DIFFICULTY:
+                    if (CanExecuteCommand(command)) {
+                        last_status_ = game_.game_status();
+                        game_.set_temp_ai_difficulty(game_.ai_difficulty());
+                        game_.set_game_status(GameStatus::SET_DIFFICULTY);
+                    }
+                    break;
                 case CommandType::TOGGLE_PLACEMENT_MODE:
                     if (CanExecuteCommand(command)) game_.TogglePlacementMode();
                     break;
@@ -318,6 +332,9 @@ private:
                                 game_.set_auto_ship_sizes();
                                 game_.Initialize();
                             }
+                        } else if (status_ == GameStatus::SET_DIFFICULTY && number <= 3) {
+                            game_.set_temp_ai_difficulty(number == 1 ? AIDifficulty::EASY
+                                                         : number == 2 ? AIDifficulty::MEDIUM : AIDifficulty::HARD);
                         } else if (status_ == GameStatus::SELECT_SAVE_SLOT && number <= 4) {
                             std::string slot_name = common_slot_name_ + std::to_string(number);
                             game_.set_game_status(last_status_);
@@ -351,11 +368,18 @@ private:
                         } else if (status_ == GameStatus::ASK_EXIT){
                             game_.set_game_status(GameStatus::ASK_SAVE);
                         } else if (status_ == GameStatus::SET_SIZES){
-                            game_.set_ship_fleet_spec();
-                            game_.Initialize();
+                            if (game_.temp_fleet_fit() == FleetFit::DOES_NOT_FIT) {
+                                renderer_->ShowMessage("Такой флот не помещается на поле!");
+                            } else {
+                                game_.set_ship_fleet_spec();
+                                game_.Initialize();
+                            }
                         } else if (status_ == GameStatus::SET_FIELD){
                             game_.ApplyFieldSize();
                             game_.Initialize();
+                        } else if (status_ == GameStatus::SET_DIFFICULTY){
+                            game_.ApplyAIDifficulty();
+                            game_.set_game_status(last_status_);
                         }
                     }
                     break;
@@ -372,7 +396,7 @@ private:
                             game_.set_game_status(last_status_);
                         } else if (status_ == GameStatus::SET_SIZES){
                             game_.set_game_status(last_status_);
-                        } else if (status_ == GameStatus::SET_FIELD){
+                        } else if (status_ == GameStatus::SET_FIELD || status_ == GameStatus::SET_DIFFICULTY){
                             game_.set_game_status(last_status_);
                         }
                     }
@@ -180,14 +180,14 @@ char ConsoleRenderer::CellGlyph(const PlayingField& field, int x, int y, bool re
             if (segment_state == SegmentState::DAMAGED)   return 'd';
             return 'O';
         }
-        const Cell& vis = field.visible_cell(x, y);
+        const Cell vis = field.visible_cell(x, y);
         if (vis.IsEmpty())   return '~';
         if (vis.IsUnknown()) return '.';
         return 'S';
     }
 
     // поле противника:
-    const Cell& vis = field.visible_cell(x, y);
+    const Cell vis = field.visible_cell(x, y);
 
     // (1) если уже реально открыто выстрелом
     if (!vis.IsUnknown()) {
@@ -262,6 +262,28 @@ std::vector<std::string> ConsoleRenderer::BuildFieldBlock(const PlayingField& fi
 }
 
 
+std::string ConsoleRenderer::PlacementStatusToString(PlacementStatus status) const {
+    switch (status) {
+        case PlacementStatus::OK:            return "можно поставить";
+        case PlacementStatus::INVALID_SIZE:  return "недопустимый размер корабля";
+        case PlacementStatus::OUT_OF_BOUNDS: return "корабль выходит за границы поля";
+        case PlacementStatus::OVERLAP:       return "клетки заняты другим кораблём";
+        case PlacementStatus::TOO_CLOSE:     return "слишком близко к другому кораблю";
+    }
+    return "";
+}
+
+
+std::string ConsoleRenderer::FleetFitToString(FleetFit fit) const {
+    switch (fit) {
+        case FleetFit::FITS:         return "\x1b[92mпомещается на поле\x1b[0m";
+        case FleetFit::DOES_NOT_FIT: return "\x1b[91mне помещается на поле\x1b[0m";
+        case FleetFit::UNKNOWN:      return "\x1b[93mне удалось проверить\x1b[0m";
+    }
+    return "";
+}
+
+
 std::string ConsoleRenderer::StatusToString(GameStatus status, PlacementMode mode) const {
     switch (status) {
         case GameStatus::PLACING_SHIPS: 
@@ -438,8 +460,14 @@ std::vector<std::string> ConsoleRenderer::BuildFrame(const Game& game, const std
             auto [ship_size, orientation] = game.current_ship_info();
             std::string orient_str = (orientation == Orientation::HORIZONTAL) ? "горизонтальная" : "вертикальная";
             
+            std::string placement_hint;
+            const PlacementStatus placement = game.ship_placement_status(game.cursor_x(), game.cursor_y());
+            if (placement != PlacementStatus::OK) {
+                placement_hint = " \x1b[91m(" + PlacementStatusToString(placement) + ")\x1b[0m";
+            }
+
             lines.push_back("");
-            lines.push_back("Текущий корабль: размер - " + std::to_string(ship_size) + ", ориентация - " + orient_str);
+            lines.push_back("Текущий корабль: размер - " + std::to_string(ship_size) + ", ориентация - " + orient_str + placement_hint);
         }
         else{
             lines.push_back(std::string());
@@ -788,6 +816,7 @@ void ConsoleRenderer::RenderShipSizeSelection(const Game& game, const std::strin
         "- Выб_5: стандартный флот (1x4,2x3,3x2,4x1)",
         "",
         "Созданный флот: " + game.fleet_spec_string(true),
+        "Проверка: " + FleetFitToString(game.temp_fleet_fit()),
         "Текущий флот: " + game.fleet_spec_string(),
         controls_legend
     };
@@ -69,6 +69,8 @@ private:
     void MoveCursor(int row, int col);
 
     std::string StatusToString(GameStatus status_, PlacementMode mode) const;
+    std::string PlacementStatusToString(PlacementStatus status) const;
+    std::string FleetFitToString(FleetFit fit) const;
 
     void PushLog(const std::string& msg);
 
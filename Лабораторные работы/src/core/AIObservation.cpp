@@ -0,0 +1,361 @@
+#include "AIObservation.h"
+#include <random>
+#include "PlayingField.h"
+
+
+
+AIObservation::CellSet::CellSet() {
+    slot_.fill(-1);
+}
+
+
+void AIObservation::CellSet::Insert(int cell) {
+    if (slot_[cell] >= 0) return;
+    slot_[cell] = static_cast<std::int16_t>(size_);
+    cells_[size_++] = static_cast<std::uint8_t>(cell);
+}
+
+
+void AIObservation::CellSet::Erase(int cell) {
+    const int slot = slot_[cell];
+    if (slot < 0) return;
+    // На освободившееся место встаёт последняя клетка списка.
+    const int last = cells_[--size_];
+    cells_[slot] = static_cast<std::uint8_t>(last);
+    slot_[last] = static_cast<std::int16_t>(slot);
+    slot_[cell] = -1;
+}
+
+
+AIObservation::AIObservation(int x_size, int y_size, const std::vector<int>& fleet)
+        : x_size_(x_size), y_size_(y_size) {
+    for (int size : fleet) {
+        if (size >= 1 && size <= Ship::kMaxSize) alive_by_size_[size]++;
+    }
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        indexes_[size] = &PlacementIndex::Get(x_size_, y_size_, size);
+        for (const Placement& placement : *indexes_[size]) {
+            valid_[size].set(static_cast<std::size_t>(&placement - indexes_[size]->begin()));
+            for (int k = 0; k < size; ++k) {
+                const int x = placement.x + (placement.orientation == Orientation::HORIZONTAL ? k : 0);
+                const int y = placement.y + (placement.orientation == Orientation::VERTICAL ? k : 0);
+                counts_[size][Bitboard::BitIndex(x, y)]++;
+            }
+        }
+    }
+    for (int y = 0; y < y_size_; ++y) {
+        for (int x = 0; x < x_size_; ++x) unknown_.Insert(Bitboard::BitIndex(x, y));
+    }
+}
+
+
+AIObservation AIObservation::FromVisibleField(const PlayingField& field, const std::vector<int>& fleet) {
+    AIObservation observation(field.x_size(), field.y_size(), fleet);
+    Bitboard destroyed;
+    for (int y = 0; y < field.y_size(); ++y) {
+        for (int x = 0; x < field.x_size(); ++x) {
+            const Cell vis = field.visible_cell(x, y);
+            if (vis.IsUnknown()) continue;
+            if (!vis.IsShip()) {
+                observation.MarkWater(x, y);
+                continue;
+            }
+            observation.MarkHit(x, y);
+            if (field.IsVisibleSegmentDestroyed(x, y)) {
+                observation.damaged_.Erase(Bitboard::BitIndex(x, y));
+                destroyed.Set(x, y);
+            }
+        }
+    }
+
+    // Корабли не касаются, поэтому попадания подряд, вокруг которых вся вода открыта, — это
+    // корабль целиком. Если все его сегменты уничтожены, он потоплен. У корабля, который ещё
+    // не потоплен, за крайним попаданием стоит неоткрытая клетка с его же сегментом.
+    Bitboard hits = observation.hits_;
+    for (int bit = hits.FirstSet(); bit >= 0; bit = hits.FirstSet()) {
+        const int x = bit % Bitboard::kStride;
+        const int y = bit / Bitboard::kStride;
+        hits.Reset(x, y);
+        // Каждый корабль рассматривается один раз, с его левой или верхней клетки.
+        if ((x > 0 && observation.hits_.Test(x - 1, y)) || (y > 0 && observation.hits_.Test(x, y - 1))) continue;
+        const bool horizontal = x + 1 < field.x_size() && observation.hits_.Test(x + 1, y);
+        int size = 1;
+        while (size <= Ship::kMaxSize && (horizontal ? x + size < field.x_size() && observation.hits_.Test(x + size, y)
+                                                     : y + size < field.y_size() && observation.hits_.Test(x, y + size))) {
+            ++size;
+        }
+        if (size > Ship::kMaxSize) continue;
+        const Placement* placement = observation.indexes_[size]->Find(
+            x, y, horizontal ? Orientation::HORIZONTAL : Orientation::VERTICAL);
+        if (placement == nullptr || placement->ship.AndNot(destroyed).Any()) continue;
+        if (placement->halo.AndNot(placement->ship).AndNot(observation.water_).Any()) continue;
+        observation.MarkSunk(x, y);
+    }
+    return observation;
+}
+
+
+template <typename Visitor>
+void AIObservation::ForEachPlacementAt(int size, int x, int y, Visitor visit) const {
+    const PlacementIndex& index = *indexes_[size];
+    for (int k = 0; k < size; ++k) {
+        if (const Placement* horizontal = index.Find(x - k, y, Orientation::HORIZONTAL)) {
+            visit(*horizontal, static_cast<int>(horizontal - index.begin()));
+        }
+        // У однопалубного корабля вертикальная позиция та же, что и горизонтальная.
+        if (size == 1) continue;
+        if (const Placement* vertical = index.Find(x, y - k, Orientation::VERTICAL)) {
+            visit(*vertical, static_cast<int>(vertical - index.begin()));
+        }
+    }
+}
+
+
+bool AIObservation::ChooseDamagedSegment(Rng& rng, int& x, int& y) const {
+    if (damaged_.size() == 0) {
+        return false;
+    }
+    std::uniform_int_distribution<int> dist(0, damaged_.size() - 1);
+    const int cell = damaged_[dist(rng)];
+    x = cell % Bitboard::kStride;
+    y = cell / Bitboard::kStride;
+    return true;
+}
+
+
+bool AIObservation::ChooseTarget(Rng& rng, int& x, int& y) {
+    if (ChooseDamagedSegment(rng, x, y)) {
+        return true;
+    }
+
+    int cell = -1;
+
+    // Среди клеток с наибольшим весом каждая выбирается с равной вероятностью.
+    std::uint32_t best = 0;
+    int ties = 0;
+    auto consider = [&](int candidate, std::uint32_t weight) {
+        if (weight == 0 || weight < best) return;
+        if (weight > best) {
+            best = weight;
+            ties = 0;
+        }
+        std::uniform_int_distribution<int> dist(0, ties++);
+        if (dist(rng) == 0) cell = candidate;
+    };
+
+    // Добивание: только позиции, которые проходят через попадания в ещё не потопленный корабль.
+    Bitboard open_hits = hits_.AndNot(sunk_);
+    if (open_hits.Any()) {
+        std::array<std::uint32_t, Bitboard::kWords * 64> weights{};
+        for (int bit = open_hits.FirstSet(); bit >= 0; bit = open_hits.FirstSet()) {
+            const int hx = bit % Bitboard::kStride;
+            const int hy = bit / Bitboard::kStride;
+            open_hits.Reset(hx, hy);
+            for (int size = 1; size <= Ship::kMaxSize; ++size) {
+                if (alive_by_size_[size] == 0) continue;
+                ForEachPlacementAt(size, hx, hy, [&](const Placement& placement, int index) {
+                    if (!valid_[size].test(static_cast<std::size_t>(index))) return;
+                    for (int k = 0; k < size; ++k) {
+                        const int px = placement.x + (placement.orientation == Orientation::HORIZONTAL ? k : 0);
+                        const int py = placement.y + (placement.orientation == Orientation::VERTICAL ? k : 0);
+                        if (IsUnknown(px, py)) weights[Bitboard::BitIndex(px, py)] += alive_by_size_[size];
+                    }
+                });
+            }
+        }
+        for (int i = 0; i < unknown_.size(); ++i) {
+            consider(unknown_[i], weights[unknown_[i]]);
+        }
+    }
+
+    // Поиск: все согласованные позиции живых кораблей. Клетку с нулевым весом можно выбросить
+    // насовсем: позиции только отключаются, а живых кораблей только убывает.
+    if (cell < 0) {
+        for (int i = unknown_.size() - 1; i >= 0; --i) {
+            const int candidate = unknown_[i];
+            std::uint32_t weight = 0;
+            for (int size = 1; size <= Ship::kMaxSize; ++size) {
+                weight += static_cast<std::uint32_t>(alive_by_size_[size]) * counts_[size][candidate];
+            }
+            if (weight == 0) {
+                unknown_.Erase(candidate);
+                continue;
+            }
+            consider(candidate, weight);
+        }
+    }
+    if (cell < 0) {
+        return false;
+    }
+
+    x = cell % Bitboard::kStride;
+    y = cell / Bitboard::kStride;
+    return true;
+}
+
+
+void AIObservation::Record(int x, int y, int result, int damage) {
+    if (x < 0 || y < 0 || x >= x_size_ || y >= y_size_ || result < 0) {
+        return;
+    }
+    if (result == 0) {
+        MarkWater(x, y);
+        return;
+    }
+
+    if (hits_.Test(x, y)) {
+        damaged_.Erase(Bitboard::BitIndex(x, y));
+    } else {
+        MarkHit(x, y);
+        if (damage >= 2) damaged_.Erase(Bitboard::BitIndex(x, y));
+    }
+    if (result == 2) {
+        MarkSunk(x, y);
+    }
+}
+
+
+void AIObservation::RecordScan(int x, int y, bool ship) {
+    if (x < 0 || y < 0 || x >= x_size_ || y >= y_size_ || ship) {
+        return;
+    }
+    MarkWater(x, y);
+}
+
+
+void AIObservation::MarkWater(int x, int y) {
+    if (water_.Test(x, y) || hits_.Test(x, y)) return;
+    const int cell = Bitboard::BitIndex(x, y);
+    water_.Set(x, y);
+    unknown_.Erase(cell);
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        ForEachPlacementAt(size, x, y, [&](const Placement& placement, int index) {
+            Invalidate(size, placement, index);
+        });
+    }
+}
+
+
+void AIObservation::MarkHit(int x, int y) {
+    if (hits_.Test(x, y)) return;
+    const int cell = Bitboard::BitIndex(x, y);
+    hits_.Set(x, y);
+    unknown_.Erase(cell);
+    damaged_.Insert(cell);
+
+    // Корабль, который проходит рядом с попаданием, но не через него, касался бы подбитого.
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= x_size_ || ny >= y_size_) continue;
+            for (int size = 1; size <= Ship::kMaxSize; ++size) {
+                ForEachPlacementAt(size, nx, ny, [&](const Placement& placement, int index) {
+                    if (!placement.ship.Test(x, y)) Invalidate(size, placement, index);
+                });
+            }
+        }
+    }
+}
+
+
+void AIObservation::MarkSunk(int x, int y) {
+    // Корабли не касаются друг друга, поэтому потопленный корабль — это попадания подряд
+    // по строке или по столбцу от клетки последнего выстрела.
+    int left = x, right = x, top = y, bottom = y;
+    while (left > 0 && hits_.Test(left - 1, y)) --left;
+    while (right + 1 < x_size_ && hits_.Test(right + 1, y)) ++right;
+    while (top > 0 && hits_.Test(x, top - 1)) --top;
+    while (bottom + 1 < y_size_ && hits_.Test(x, bottom + 1)) ++bottom;
+
+    const bool horizontal = right > left;
+    const int size = horizontal ? right - left + 1 : bottom - top + 1;
+    const Orientation orientation = horizontal ? Orientation::HORIZONTAL : Orientation::VERTICAL;
+    const int start_x = horizontal ? left : x;
+    const int start_y = horizontal ? y : top;
+    if (size > Ship::kMaxSize || sunk_.Test(start_x, start_y)) {
+        return;
+    }
+
+    const Placement* placement = indexes_[size]->Find(start_x, start_y, orientation);
+    if (placement == nullptr) {
+        return;
+    }
+    sunk_ |= placement->ship;
+    if (alive_by_size_[size] > 0) alive_by_size_[size]--;
+
+    Bitboard ship_cells = placement->ship;
+    for (int bit = ship_cells.FirstSet(); bit >= 0; bit = ship_cells.FirstSet()) {
+        const int cx = bit % Bitboard::kStride;
+        const int cy = bit / Bitboard::kStride;
+        ship_cells.Reset(cx, cy);
+        damaged_.Erase(bit);
+        for (int other = 1; other <= Ship::kMaxSize; ++other) {
+            ForEachPlacementAt(other, cx, cy, [&](const Placement& covering, int index) {
+                Invalidate(other, covering, index);
+            });
+        }
+    }
+    // Вокруг потопленного корабля кораблей нет.
+    Bitboard halo = placement->halo.AndNot(placement->ship);
+    for (int bit = halo.FirstSet(); bit >= 0; bit = halo.FirstSet()) {
+        halo.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+        MarkWater(bit % Bitboard::kStride, bit / Bitboard::kStride);
+    }
+}
+
+
+void AIObservation::Invalidate(int size, const Placement& placement, int index) {
+    if (!valid_[size].test(static_cast<std::size_t>(index))) return;
+    valid_[size].reset(static_cast<std::size_t>(index));
+    for (int k = 0; k < size; ++k) {
+        const int x = placement.x + (placement.orientation == Orientation::HORIZONTAL ? k : 0);
+        const int y = placement.y + (placement.orientation == Orientation::VERTICAL ? k : 0);
+        counts_[size][Bitboard::BitIndex(x, y)]--;
+    }
+}
+
+
+bool AIObservation::IsUnknown(int x, int y) const {
+    return !water_.Test(x, y) && !hits_.Test(x, y);
+}
+
+
+int AIObservation::alive_ships_of_size(int size) const {
+    return (size >= 1 && size <= Ship::kMaxSize) ? alive_by_size_[size] : 0;
+}
+
+
+bool AIObservation::placement_valid(int size, int index) const {
+    return valid_[size].test(static_cast<std::size_t>(index));
+}
+
+
+int AIObservation::placement_count(int size, int x, int y) const {
+    return counts_[size][Bitboard::BitIndex(x, y)];
+}
+
+
+const Bitboard& AIObservation::water() const {
+    return water_;
+}
+
+
+const Bitboard& AIObservation::hits() const {
+    return hits_;
+}
+
+
+const Bitboard& AIObservation::sunk() const {
+    return sunk_;
+}
+
+
+int AIObservation::x_size() const {
+    return x_size_;
+}
+
+
+int AIObservation::y_size() const {
+    return y_size_;
+}
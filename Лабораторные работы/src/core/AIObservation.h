@@ -0,0 +1,106 @@
+#ifndef BATTLESHIP_CORE_AIOBSERVATION_H_
+#define BATTLESHIP_CORE_AIOBSERVATION_H_
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "PlacementIndex.h"
+#include "Random.h"
+#include "Ship.h"
+
+class PlayingField;
+
+// Что ИИ знает о поле противника: только результаты собственных выстрелов.
+//
+// Клетка либо неизвестна, либо вода, либо попадание. Для каждого размера корабля хранится,
+// какие позиции из PlacementIndex ещё согласуются с наблюдениями (не задевают воду
+// и потопленные корабли и не касаются чужих попаданий), и сколько таких позиций проходит
+// через каждую клетку. Выстрел отключает только позиции рядом с клеткой выстрела, поэтому
+// счётчики обновляются за время, не зависящее от размера поля, и настоящее поле не нужно.
+// Выстрелы ИИ наносят по одному урону, поэтому второе попадание в клетку уничтожает сегмент.
+class AIObservation {
+public:
+    AIObservation() = default;
+    AIObservation(int x_size, int y_size, const std::vector<int>& fleet);
+
+    // Наблюдение по тому, что на поле уже открыто: для загруженной партии или нового раунда.
+    // Читает только visible_cell и IsVisibleSegmentDestroyed. Потопленный корабль — попадания
+    // подряд, все уничтоженные, вокруг которых открыта вода.
+    static AIObservation FromVisibleField(const PlayingField& field, const std::vector<int>& fleet);
+
+    // Цель следующего выстрела по плотности позиций. Сначала добиваются подбитые сегменты.
+    // Если есть попадания в непотопленный корабль, считаются только позиции через них,
+    // иначе все согласованные позиции живых кораблей, с весом по числу таких кораблей.
+    // Из клеток с наибольшим весом выбирается случайная. Возвращает false, если стрелять некуда.
+    bool ChooseTarget(Rng& rng, int& x, int& y);
+    // Случайный сегмент, подбитый один раз: второй выстрел в него — гарантированное попадание.
+    bool ChooseDamagedSegment(Rng& rng, int& x, int& y) const;
+
+    // Учесть результат выстрела по (x, y) в обозначениях PlayingField::Damage. damage — урон
+    // выстрела: двойной урон способности уничтожает сегмент сразу.
+    void Record(int x, int y, int result, int damage = 1);
+    // Учесть клетку, которую показал сканер. Сегмент корабля остаётся неизвестной клеткой:
+    // стрелять в него всё равно дважды.
+    void RecordScan(int x, int y, bool ship);
+
+    bool IsUnknown(int x, int y) const;
+    int alive_ships_of_size(int size) const;
+    // Согласуется ли позиция index из PlacementIndex для корабля size с наблюдениями.
+    bool placement_valid(int size, int index) const;
+    // Сколько согласованных позиций корабля size накрывают клетку (x, y).
+    int placement_count(int size, int x, int y) const;
+    const Bitboard& water() const;
+    const Bitboard& hits() const;
+    const Bitboard& sunk() const;
+
+    int x_size() const;
+    int y_size() const;
+
+private:
+    // Множество клеток доски: номера клеток подряд и место каждой клетки в этом списке.
+    class CellSet {
+    public:
+        CellSet();
+
+        void Insert(int cell);
+        void Erase(int cell);
+        bool Contains(int cell) const { return slot_[cell] >= 0; }
+
+        int size() const { return size_; }
+        int operator[](int index) const { return cells_[index]; }
+
+    private:
+        static constexpr int kCells = Bitboard::kWords * 64;
+
+        std::array<std::uint8_t, kCells> cells_{};
+        std::array<std::int16_t, kCells> slot_{};
+        int size_ = 0;
+    };
+
+    static constexpr int kMaxPlacements = 2 * Bitboard::kMaxSide * Bitboard::kMaxSide;
+
+    void MarkWater(int x, int y);
+    void MarkHit(int x, int y);
+    void MarkSunk(int x, int y);
+    void Invalidate(int size, const Placement& placement, int index);
+    // Позиции корабля size, накрывающие клетку (x, y).
+    template <typename Visitor>
+    void ForEachPlacementAt(int size, int x, int y, Visitor visit) const;
+
+    int x_size_ = 0;
+    int y_size_ = 0;
+    Bitboard water_;
+    Bitboard hits_;
+    Bitboard sunk_;
+    std::array<int, Ship::kMaxSize + 1> alive_by_size_{};
+    std::array<const PlacementIndex*, Ship::kMaxSize + 1> indexes_{};
+    std::array<std::bitset<kMaxPlacements>, Ship::kMaxSize + 1> valid_;
+    std::array<std::array<std::uint16_t, Bitboard::kWords * 64>, Ship::kMaxSize + 1> counts_{};
+
+    CellSet damaged_;
+    CellSet unknown_;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef BATTLESHIP_CORE_BITBOARD_H_
+#define BATTLESHIP_CORE_BITBOARD_H_
+
+#include <array>
+#include <cstdint>
+#include "Ship.h"
+
+// Битовая доска для полей до 14x14. Строка занимает 16 бит, поэтому справа от
+// каждой строки всегда есть минимум два пустых «защитных» столбца: сдвиг на 1
+// не переносит клетки между строками, а сдвиг на kStride переходит к соседней строке.
+class Bitboard {
+public:
+    static constexpr int kStride = 16;
+    static constexpr int kMaxSide = 14;
+    static constexpr int kWords = 4;
+
+    constexpr Bitboard() : words_{} {}
+
+    static constexpr int BitIndex(int x, int y) { return y * kStride + x; }
+
+    constexpr bool Test(int x, int y) const {
+        const int bit = BitIndex(x, y);
+        return (words_[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    constexpr void Set(int x, int y) {
+        const int bit = BitIndex(x, y);
+        words_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+
+    constexpr void Reset(int x, int y) {
+        const int bit = BitIndex(x, y);
+        words_[bit / 64] &= ~(std::uint64_t{1} << (bit % 64));
+    }
+
+    constexpr void Clear() {
+        for (auto& w : words_) w = 0;
+    }
+
+    constexpr bool Any() const {
+        return (words_[0] | words_[1] | words_[2] | words_[3]) != 0;
+    }
+
+    constexpr bool Intersects(const Bitboard& other) const {
+        return ((words_[0] & other.words_[0]) | (words_[1] & other.words_[1]) |
+                (words_[2] & other.words_[2]) | (words_[3] & other.words_[3])) != 0;
+    }
+
+    int Count() const {
+        return __builtin_popcountll(words_[0]) + __builtin_popcountll(words_[1]) +
+               __builtin_popcountll(words_[2]) + __builtin_popcountll(words_[3]);
+    }
+
+    // Индекс младшего установленного бита или -1, если доска пуста.
+    int FirstSet() const {
+        for (int i = 0; i < kWords; ++i) {
+            if (words_[i] != 0) return i * 64 + __builtin_ctzll(words_[i]);
+        }
+        return -1;
+    }
+
+    // Индекс n-го (с нуля) установленного бита или -1, если установленных битов не больше n.
+    int NthSet(int n) const;
+
+    constexpr std::uint64_t word(int index) const { return words_[index]; }
+
+    constexpr Bitboard& operator|=(const Bitboard& other) {
+        for (int i = 0; i < kWords; ++i) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    constexpr Bitboard& operator&=(const Bitboard& other) {
+        for (int i = 0; i < kWords; ++i) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    constexpr Bitboard operator|(const Bitboard& other) const { Bitboard r = *this; return r |= other; }
+    constexpr Bitboard operator&(const Bitboard& other) const { Bitboard r = *this; return r &= other; }
+
+    constexpr Bitboard AndNot(const Bitboard& other) const {
+        Bitboard r;
+        for (int i = 0; i < kWords; ++i) r.words_[i] = words_[i] & ~other.words_[i];
+        return r;
+    }
+
+    constexpr bool operator==(const Bitboard& other) const {
+        for (int i = 0; i < kWords; ++i) {
+            if (words_[i] != other.words_[i]) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const Bitboard& other) const { return !(*this == other); }
+
+    // Сдвиг в сторону старших битов (вправо/вниз по полю); выдвинутые биты теряются.
+    constexpr Bitboard operator<<(int n) const {
+        Bitboard r;
+        const int word_shift = n / 64;
+        const int bit_shift = n % 64;
+        for (int i = kWords - 1; i >= word_shift; --i) {
+            std::uint64_t v = words_[i - word_shift] << bit_shift;
+            if (bit_shift != 0 && i - word_shift - 1 >= 0) {
+                v |= words_[i - word_shift - 1] >> (64 - bit_shift);
+            }
+            r.words_[i] = v;
+        }
+        return r;
+    }
+
+    constexpr Bitboard operator>>(int n) const {
+        Bitboard r;
+        const int word_shift = n / 64;
+        const int bit_shift = n % 64;
+        for (int i = 0; i + word_shift < kWords; ++i) {
+            std::uint64_t v = words_[i + word_shift] >> bit_shift;
+            if (bit_shift != 0 && i + word_shift + 1 < kWords) {
+                v |= words_[i + word_shift + 1] << (64 - bit_shift);
+            }
+            r.words_[i] = v;
+        }
+        return r;
+    }
+
+    // Клетки доски вместе со всеми восемью соседями каждой клетки.
+    // Соседи слева от нулевого столбца попадают в защитный столбец предыдущей строки.
+    constexpr Bitboard Dilated() const {
+        const Bitboard row = *this | (*this << 1) | (*this >> 1);
+        return row | (row << kStride) | (row >> kStride);
+    }
+
+private:
+    std::array<std::uint64_t, kWords> words_;
+};
+
+
+namespace bitboard_detail {
+
+constexpr int kMaxShipSize = 4;
+
+// Шаблоны строятся с началом в клетке (1, 1), чтобы ореол не уходил в отрицательные координаты.
+constexpr Bitboard ShipTemplate(int size, Orientation orientation) {
+    Bitboard mask;
+    for (int i = 0; i < size; ++i) {
+        if (orientation == Orientation::HORIZONTAL) mask.Set(1 + i, 1);
+        else mask.Set(1, 1 + i);
+    }
+    return mask;
+}
+
+struct ShipTemplates {
+    Bitboard ship[kMaxShipSize + 1][2];
+    Bitboard halo[kMaxShipSize + 1][2];
+};
+
+constexpr ShipTemplates MakeShipTemplates() {
+    ShipTemplates t{};
+    for (int size = 1; size <= kMaxShipSize; ++size) {
+        for (int o = 0; o < 2; ++o) {
+            t.ship[size][o] = ShipTemplate(size, static_cast<Orientation>(o));
+            t.halo[size][o] = t.ship[size][o].Dilated();
+        }
+    }
+    return t;
+}
+
+constexpr ShipTemplates kShipTemplates = MakeShipTemplates();
+constexpr int kTemplateOrigin = Bitboard::kStride + 1;
+
+// kSelectInByte[b][n] — номер n-го установленного бита байта b.
+constexpr std::array<std::array<std::uint8_t, 8>, 256> MakeSelectInByte() {
+    std::array<std::array<std::uint8_t, 8>, 256> table{};
+    for (int byte = 0; byte < 256; ++byte) {
+        int n = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            if ((byte >> bit) & 1) table[byte][n++] = static_cast<std::uint8_t>(bit);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<std::uint8_t, 8>, 256> kSelectInByte = MakeSelectInByte();
+
+}  // namespace bitboard_detail
+
+
+// Номер n-го (с нуля) установленного бита слова; n должно быть меньше числа единиц в слове.
+// Без ветвлений: в каждом байте считается, сколько единиц в нём и в младших байтах, байт
+// с n-й единицей — первый, где их больше n, а внутри байта помогает таблица.
+inline int NthSetBit(std::uint64_t word, int n) {
+    constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+    constexpr std::uint64_t kHighs = 0x8080808080808080ull;
+    std::uint64_t bytes = word - ((word >> 1) & 0x5555555555555555ull);
+    bytes = (bytes & 0x3333333333333333ull) + ((bytes >> 2) & 0x3333333333333333ull);
+    bytes = (bytes + (bytes >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    const std::uint64_t prefix = bytes * kOnes;
+    // Старший бит байта остаётся, если единиц до конца байта не больше n.
+    const int byte = __builtin_popcountll(((static_cast<std::uint64_t>(n) * kOnes | kHighs) - prefix) & kHighs);
+    const int before = static_cast<int>(((prefix << 8) >> (8 * byte)) & 0xFF);
+    return 8 * byte + bitboard_detail::kSelectInByte[(word >> (8 * byte)) & 0xFF][n - before];
+}
+
+
+inline int Bitboard::NthSet(int n) const {
+    for (int i = 0; i < kWords; ++i) {
+        const int count = __builtin_popcountll(words_[i]);
+        if (n < count) return i * 64 + NthSetBit(words_[i], n);
+        n -= count;
+    }
+    return -1;
+}
+
+
+// Маска клеток корабля размером 1..4 с началом в (x, y).
+constexpr Bitboard ShipMask(int x, int y, int size, Orientation orientation) {
+    return (bitboard_detail::kShipTemplates.ship[size][static_cast<int>(orientation)]
+            << Bitboard::BitIndex(x, y)) >> bitboard_detail::kTemplateOrigin;
+}
+
+// Маска корабля вместе с соседними клетками, в которые нельзя ставить другие корабли.
+constexpr Bitboard HaloMask(int x, int y, int size, Orientation orientation) {
+    return (bitboard_detail::kShipTemplates.halo[size][static_cast<int>(orientation)]
+            << Bitboard::BitIndex(x, y)) >> bitboard_detail::kTemplateOrigin;
+}
+
+// Все клетки поля w x h.
+constexpr Bitboard BoardMask(int w, int h) {
+    Bitboard mask;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) mask.Set(x, y);
+    }
+    return mask;
+}
+
+#endif
@@ -1,64 +1,51 @@
 #include "Cell.h"
 
-Cell::Cell(CellState state) : state_(state), ship_index_(-1), segment_index_(-1) {}
-
-
-Cell::Cell(const Cell& other) : state_(other.state_), ship_index_(other.ship_index_), segment_index_(other.segment_index_) {}
-
-
-Cell& Cell::operator=(const Cell& other) {
-    if (this != &other) {
-        state_ = other.state_;
-        ship_index_ = other.ship_index_;
-        segment_index_ = other.segment_index_;
-    }
-    return *this;
-}
+Cell::Cell(CellState state) : state_(static_cast<std::uint16_t>(state)), ship_index_(-1), segment_index_(-1) {}
 
 
 bool Cell::IsUnknown() const { 
-    return state_ == CellState::UNKNOWN; 
+    return segment_state() == CellState::UNKNOWN; 
 }
 
 
 bool Cell::IsEmpty() const { 
-    return state_ == CellState::EMPTY; 
+    return segment_state() == CellState::EMPTY; 
 }
 
 
 bool Cell::IsShip() const { 
-    return state_ == CellState::SHIP; 
+    return segment_state() == CellState::SHIP; 
 }
 
 
 bool Cell::CanBeShot() const {
-    return state_ == CellState::UNKNOWN || state_ == CellState::SHIP;
+    return segment_state() == CellState::UNKNOWN || segment_state() == CellState::SHIP;
 }
 
 
 void Cell::reset() {
-    state_ = CellState::EMPTY;
+    state_ = static_cast<std::uint16_t>(CellState::EMPTY);
     ship_index_ = -1;
     segment_index_ = -1;
 }
 
 
 void Cell::set_unknown() {
-    state_ = CellState::UNKNOWN;
+    state_ = static_cast<std::uint16_t>(CellState::UNKNOWN);
     segment_index_ = -2;
     ship_index_ = -2;
 }
 
 
 void Cell::set_empty() {
-    state_ = CellState::EMPTY;
+    state_ = static_cast<std::uint16_t>(CellState::EMPTY);
     ship_index_ = -1;
     segment_index_ = -1;
 }
 
 
 void Cell::set_ship(int ind, int number) {
-    state_ = CellState::SHIP;
+    state_ = static_cast<std::uint16_t>(CellState::SHIP);
     segment_index_ = ind;
     ship_index_ = number;
 }
@@ -85,10 +72,10 @@ void Cell::set_segment_index(int index){
 
 
 CellState Cell::segment_state() const { 
-    return state_; 
+    return static_cast<CellState>(state_); 
 }
 
 
 void Cell::set_state(CellState new_state){
-    state_ = new_state;
+    state_ = static_cast<std::uint16_t>(new_state);
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef BATTLESHIP_CORE_CELL_H_
 #define BATTLESHIP_CORE_CELL_H_
 
-enum class CellState {
+#include <cstdint>
+
+enum class CellState : std::uint8_t {
     UNKNOWN,
     EMPTY,
     SHIP
@@ -10,8 +12,6 @@ enum class CellState {
 class Cell {
 public:
     Cell(CellState state);
-    Cell(const Cell& other);
-    Cell& operator=(const Cell& other);
     
     bool IsUnknown() const;
     bool IsEmpty() const;
@@ -34,9 +34,11 @@ public:
     void set_state(CellState new_state);
 
 private:
-    CellState state_;
-    int ship_index_;
-    int segment_index_;
+    // Клетка упакована в 2 байта: состояние, номер корабля и номер сегмента
+    // (флот не больше 16 кораблей, корабль не длиннее 4 клеток, -1/-2 — служебные значения).
+    std::uint16_t state_ : 2;
+    std::int16_t ship_index_ : 8;
+    std::int16_t segment_index_ : 6;
 };
 
 #endif
\ No newline at end of file
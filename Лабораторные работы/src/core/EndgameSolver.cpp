@@ -0,0 +1,356 @@
+#include "EndgameSolver.h"
+#include <algorithm>
+#include <limits>
+
+
+
+namespace {
+
+// Разница ожиданий меньше этой считается равенством: при равенстве остаётся первый выстрел.
+constexpr double kEpsilon = 1e-9;
+// Как часто перебор смотрит на часы.
+constexpr std::size_t kNodesPerClockCheck = 64;
+
+}
+
+
+std::size_t EndgameSolver::FleetStateHash::operator()(const FleetState& state) const {
+    std::uint64_t hash = 1469598103934665603ull ^ state.counts;
+    for (int i = 0; i < Bitboard::kWords; ++i) {
+        hash = (hash ^ state.free_cells.word(i)) * 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+
+std::size_t EndgameSolver::SearchStateHash::operator()(const SearchState& state) const {
+    std::uint64_t hash = (state.layouts ^ 1469598103934665603ull) * 1099511628211ull;
+    hash ^= hash >> 29;
+    hash = (hash ^ state.hits) * 1099511628211ull;
+    hash ^= hash >> 29;
+    return static_cast<std::size_t>(hash);
+}
+
+
+EndgameSolver::EndgameSolver(const EndgameSettings& settings) : settings_(settings) {}
+
+
+bool EndgameSolver::ChooseTarget(const AIObservation& observation, int& x, int& y, Deadline deadline) {
+    if (MaxLayouts() == 0 || std::chrono::steady_clock::now() >= deadline) {
+        return false;
+    }
+    int alive = 0;
+    for (int size = 1; size <= Ship::kMaxSize; ++size) alive += observation.alive_ships_of_size(size);
+    if (alive == 0 || alive > std::min(settings_.max_ships, kMaxShips)) {
+        return false;
+    }
+
+    nodes_ = 0;
+    deadline_ = deadline;
+    exhausted_ = false;
+    if (!Enumerate(observation)) {
+        return false;
+    }
+
+    expected_.clear();
+    const std::uint64_t all = (layouts_.size() == 64) ? ~std::uint64_t{0}
+                                                       : (std::uint64_t{1} << layouts_.size()) - 1;
+    int best = -1;
+    const double probes = Expected(all, 0, &best);
+    if (exhausted_ || best < 0) {
+        return false;
+    }
+
+    // Во всех расстановках неподбитых клеток поровну, и в каждую нужен ещё один выстрел.
+    expected_shots_ = probes + __builtin_popcountll(layouts_.front().cells);
+    layout_count_ = static_cast<int>(layouts_.size());
+    x = cells_[best] % Bitboard::kStride;
+    y = cells_[best] / Bitboard::kStride;
+    return true;
+}
+
+
+bool EndgameSolver::Enumerate(const AIObservation& observation) {
+    const int x_size = observation.x_size();
+    const int y_size = observation.y_size();
+    Fleet fleet{};
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        indexes_[size] = &PlacementIndex::Get(x_size, y_size, size);
+        fleet[size] = observation.alive_ships_of_size(size);
+        valid_[size].clear();
+        for (int i = 0; i < indexes_[size]->count(); ++i) {
+            if (observation.placement_valid(size, i)) valid_[size].push_back(i);
+        }
+    }
+    open_hits_ = observation.hits().AndNot(observation.sunk());
+    const Bitboard free_cells = BoardMask(x_size, y_size).AndNot(observation.water() | observation.sunk());
+
+    feasible_.clear();
+    found_.clear();
+    std::vector<const Placement*> chosen;
+    if (!Extend(fleet, free_cells, 0, chosen) || found_.empty()) {
+        return false;
+    }
+
+    // Клетки, которые ещё стоит обстреливать, нумеруются подряд, чтобы множества клеток
+    // и расстановок поместились в 64-битные маски.
+    Bitboard unhit;
+    for (const std::vector<const Placement*>& layout : found_) {
+        for (const Placement* placement : layout) unhit |= placement->ship;
+    }
+    unhit = unhit.AndNot(open_hits_);
+    if (unhit.Count() > 64) {
+        return false;
+    }
+    cells_.clear();
+    std::array<int, Bitboard::kWords * 64> compact{};
+    for (int bit = unhit.FirstSet(); bit >= 0; bit = unhit.FirstSet()) {
+        unhit.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+        compact[bit] = static_cast<int>(cells_.size());
+        cells_.push_back(bit);
+    }
+
+    layouts_.assign(found_.size(), Layout());
+    for (std::size_t i = 0; i < found_.size(); ++i) {
+        Layout& layout = layouts_[i];
+        for (const Placement* placement : found_[i]) {
+            Bitboard ship = placement->ship.AndNot(open_hits_);
+            std::uint64_t mask = 0;
+            for (int bit = ship.FirstSet(); bit >= 0; bit = ship.FirstSet()) {
+                ship.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+                mask |= std::uint64_t{1} << compact[bit];
+            }
+            layout.placements[layout.ship_count] = placement;
+            layout.ships[layout.ship_count++] = mask;
+            layout.cells |= mask;
+        }
+    }
+    return true;
+}
+
+
+bool EndgameSolver::Extend(Fleet& fleet, const Bitboard& free_cells, int first,
+                           std::vector<const Placement*>& chosen) {
+    const int size = LargestSize(fleet);
+    if (size == 0) {
+        if ((open_hits_ & free_cells).Any()) {
+            return true;
+        }
+        if (found_.size() == MaxLayouts()) {
+            return false;
+        }
+        found_.push_back(chosen);
+        return true;
+    }
+
+    // Корабли одного размера ставятся по возрастанию номера позиции, чтобы каждая
+    // расстановка встретилась один раз.
+    fleet[size]--;
+    const bool same_size_next = fleet[size] > 0;
+    bool ok = true;
+    const std::vector<int>& valid = valid_[size];
+    for (int k = first; ok && k < static_cast<int>(valid.size()); ++k) {
+        if (!Spend()) {
+            ok = false;
+            break;
+        }
+        const Placement& placement = (*indexes_[size])[valid[k]];
+        if (placement.ship.AndNot(free_cells).Any()) continue;
+        const Bitboard rest = free_cells.AndNot(placement.halo);
+        if (!Feasible(fleet, rest)) {
+            ok = !exhausted_;
+            continue;
+        }
+        chosen.push_back(&placement);
+        ok = Extend(fleet, rest, same_size_next ? k + 1 : 0, chosen);
+        chosen.pop_back();
+    }
+    fleet[size]++;
+    return ok;
+}
+
+
+bool EndgameSolver::Feasible(Fleet& fleet, const Bitboard& free_cells) {
+    const int size = LargestSize(fleet);
+    const Bitboard uncovered = open_hits_ & free_cells;
+    if (size == 0) {
+        return !uncovered.Any();
+    }
+    int cells_left = 0;
+    for (int s = 1; s <= Ship::kMaxSize; ++s) cells_left += s * fleet[s];
+    if (uncovered.Count() > cells_left || free_cells.Count() < cells_left) {
+        return false;
+    }
+
+    const FleetState state{free_cells, PackedCounts(fleet)};
+    const auto it = feasible_.find(state);
+    if (it != feasible_.end()) {
+        return it->second;
+    }
+
+    fleet[size]--;
+    bool result = false;
+    for (int index : valid_[size]) {
+        if (!Spend()) break;
+        const Placement& placement = (*indexes_[size])[index];
+        if (placement.ship.AndNot(free_cells).Any()) continue;
+        if (Feasible(fleet, free_cells.AndNot(placement.halo))) {
+            result = true;
+            break;
+        }
+        if (exhausted_) break;
+    }
+    fleet[size]++;
+
+    if (!exhausted_) {
+        feasible_.emplace(state, result);
+    }
+    return result;
+}
+
+
+double EndgameSolver::Expected(std::uint64_t layouts, std::uint64_t hits, int* best_cell) {
+    const int n = __builtin_popcountll(layouts);
+    std::uint64_t candidates = 0;
+    int unhit_total = 0;
+    for (std::uint64_t rest = layouts; rest != 0; rest &= rest - 1) {
+        const std::uint64_t cells = layouts_[__builtin_ctzll(rest)].cells & ~hits;
+        candidates |= cells;
+        unhit_total += __builtin_popcountll(cells);
+    }
+    if (n == 1) {
+        if (best_cell != nullptr && candidates != 0) *best_cell = __builtin_ctzll(candidates);
+        return unhit_total;
+    }
+
+    const SearchState state{layouts, hits};
+    if (best_cell == nullptr) {
+        const auto it = expected_.find(state);
+        if (it != expected_.end()) return it->second;
+    }
+
+    // Сначала выстрелы с наибольшей вероятностью попадания: у них ниже нижняя граница.
+    std::array<std::pair<int, int>, 64> order;
+    int order_size = 0;
+    for (std::uint64_t rest = candidates; rest != 0; rest &= rest - 1) {
+        const int cell = __builtin_ctzll(rest);
+        int count = 0;
+        for (std::uint64_t l = layouts; l != 0; l &= l - 1) {
+            count += static_cast<int>((layouts_[__builtin_ctzll(l)].cells >> cell) & 1u);
+        }
+        order[order_size++] = {count, cell};
+    }
+    std::stable_sort(order.begin(), order.begin() + order_size,
+                     [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+
+    double best = std::numeric_limits<double>::infinity();
+    int best_index = -1;
+    for (int i = 0; i < order_size; ++i) {
+        const int cell = order[i].second;
+        const std::uint64_t bit = std::uint64_t{1} << cell;
+        // Выстрел тратит один ход, а каждой расстановке остаётся попасть во все её неподбитые клетки.
+        double bound = unhit_total - order[i].first;
+        if (1.0 + bound / n >= best - kEpsilon) break;
+        if (!Spend()) return 0.0;
+
+        // Исходы: промах, попадание и по одному на каждую позицию потопленного корабля.
+        const std::uint64_t next_hits = hits | bit;
+        std::array<std::pair<std::uint64_t, std::uint64_t>, 66> outcomes;
+        std::array<const Placement*, 66> sunk_ships{};
+        outcomes[0] = {0, hits};
+        outcomes[1] = {0, next_hits};
+        int outcome_count = 2;
+        for (std::uint64_t l = layouts; l != 0; l &= l - 1) {
+            const int index = __builtin_ctzll(l);
+            const Layout& layout = layouts_[index];
+            const std::uint64_t mask = std::uint64_t{1} << index;
+            if ((layout.cells & bit) == 0) {
+                outcomes[0].first |= mask;
+                continue;
+            }
+            for (int j = 0; j < layout.ship_count; ++j) {
+                if ((layout.ships[j] & bit) == 0) continue;
+                if ((layout.ships[j] & ~hits) != bit) {
+                    outcomes[1].first |= mask;
+                    break;
+                }
+                int k = 2;
+                while (k < outcome_count && sunk_ships[k] != layout.placements[j]) ++k;
+                if (k == outcome_count) {
+                    sunk_ships[k] = layout.placements[j];
+                    outcomes[outcome_count++] = {0, next_hits};
+                }
+                outcomes[k].first |= mask;
+                break;
+            }
+        }
+
+        for (int k = 0; k < outcome_count; ++k) {
+            const auto& [subset, subset_hits] = outcomes[k];
+            if (subset == 0) continue;
+            int subset_unhit = 0;
+            for (std::uint64_t l = subset; l != 0; l &= l - 1) {
+                subset_unhit += __builtin_popcountll(layouts_[__builtin_ctzll(l)].cells & ~subset_hits);
+            }
+            const double value = Expected(subset, subset_hits, nullptr);
+            if (exhausted_) return 0.0;
+            bound += __builtin_popcountll(subset) * value - subset_unhit;
+            if (1.0 + bound / n >= best - kEpsilon) break;
+        }
+        const double cost = 1.0 + bound / n;
+        if (cost < best - kEpsilon) {
+            best = cost;
+            best_index = cell;
+        }
+    }
+
+    expected_.emplace(state, best);
+    if (best_cell != nullptr) *best_cell = best_index;
+    return best;
+}
+
+
+bool EndgameSolver::Spend() {
+    if (++nodes_ > settings_.node_budget) exhausted_ = true;
+    if (nodes_ % kNodesPerClockCheck == 0 && deadline_ != Deadline::max() &&
+        std::chrono::steady_clock::now() >= deadline_) {
+        exhausted_ = true;
+    }
+    return !exhausted_;
+}
+
+
+std::size_t EndgameSolver::MaxLayouts() const {
+    return static_cast<std::size_t>(std::clamp(settings_.max_layouts, 0, kMaxLayouts));
+}
+
+
+int EndgameSolver::LargestSize(const Fleet& fleet) {
+    for (int size = Ship::kMaxSize; size >= 1; --size) {
+        if (fleet[size] > 0) return size;
+    }
+    return 0;
+}
+
+
+std::uint32_t EndgameSolver::PackedCounts(const Fleet& fleet) {
+    std::uint32_t packed = 0;
+    for (int size = 1; size <= Ship::kMaxSize; ++size) packed = (packed << 8) | static_cast<std::uint32_t>(fleet[size]);
+    return packed;
+}
+
+
+double EndgameSolver::expected_shots() const {
+    return expected_shots_;
+}
+
+
+int EndgameSolver::layout_count() const {
+    return layout_count_;
+}
+
+
+const EndgameSettings& EndgameSolver::settings() const {
+    return settings_;
+}
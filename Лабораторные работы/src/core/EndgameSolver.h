@@ -0,0 +1,130 @@
+#ifndef BATTLESHIP_CORE_ENDGAMESOLVER_H_
+#define BATTLESHIP_CORE_ENDGAMESOLVER_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "AIObservation.h"
+#include "Bitboard.h"
+#include "PlacementIndex.h"
+#include "Ship.h"
+
+struct EndgameSettings {
+    // Точный перебор включается, когда согласованных расстановок оставшегося флота не больше
+    // этого числа (не больше EndgameSolver::kMaxLayouts); 0 — никогда.
+    int max_layouts = 32;
+    // Расстановки вообще перечисляются, только когда живых кораблей не больше этого.
+    int max_ships = 4;
+    // Предел шагов перебора на один ход; если его или времени не хватило, ход выбирает
+    // обычная стратегия.
+    std::size_t node_budget = 50000;
+};
+
+
+// Точный выбор выстрела в конце раунда.
+//
+// Сначала перебором перечисляются все расстановки оставшегося флота, согласованные
+// с наблюдением ИИ: корабли ставятся от больших к меньшим, одинаковые — по возрастанию
+// номера позиции, а состояния (оставшийся флот, свободные клетки), из которых флот
+// не достроить, запоминаются. Расстановки считаются равновероятными.
+// Затем ищется выстрел с наименьшим ожидаемым числом оставшихся выстрелов: выстрел делит
+// расстановки на промах, попадание и потопление, а потопление — ещё и по тому, какой
+// корабль потоплен (потопленный корабль открывается целиком вместе с ореолом).
+// Ожидание считается по всем исходам с запоминанием по (оставшиеся расстановки, попадания).
+// Каждой расстановке нужно попасть во все её неподбитые клетки, поэтому среднее их число —
+// нижняя граница, которая отсекает заведомо худшие выстрелы. Второй выстрел в каждый сегмент одинаков для всех ходов
+// и в выбор не входит, но учитывается в expected_shots.
+class EndgameSolver {
+public:
+    static constexpr int kMaxLayouts = 64;
+    static constexpr int kMaxShips = 8;
+
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    explicit EndgameSolver(const EndgameSettings& settings = EndgameSettings());
+
+    // Выстрел по точному перебору. Возвращает false, если перебор здесь не нужен, расстановок
+    // слишком много или не хватило бюджета либо времени; тогда ход нужно выбрать иначе.
+    // Подбитые сегменты перебор не добивает: их нужно добить до вызова.
+    bool ChooseTarget(const AIObservation& observation, int& x, int& y, Deadline deadline = Deadline::max());
+
+    // Ожидаемое число выстрелов до конца раунда и число расстановок после последнего
+    // успешного ChooseTarget.
+    double expected_shots() const;
+    int layout_count() const;
+
+    const EndgameSettings& settings() const;
+
+private:
+    using Fleet = std::array<int, Ship::kMaxSize + 1>;
+
+    // Расстановка в сжатых номерах клеток: бит k — клетка cells_[k].
+    struct Layout {
+        std::uint64_t cells = 0;
+        std::array<std::uint64_t, kMaxShips> ships{};
+        // Позиции тех же кораблей: по ним различаются исходы потопления.
+        std::array<const Placement*, kMaxShips> placements{};
+        int ship_count = 0;
+    };
+
+    struct FleetState {
+        Bitboard free_cells;
+        std::uint32_t counts;
+
+        bool operator==(const FleetState& other) const {
+            return counts == other.counts && free_cells == other.free_cells;
+        }
+    };
+
+    struct FleetStateHash {
+        std::size_t operator()(const FleetState& state) const;
+    };
+
+    struct SearchState {
+        std::uint64_t layouts;
+        std::uint64_t hits;
+
+        bool operator==(const SearchState& other) const {
+            return layouts == other.layouts && hits == other.hits;
+        }
+    };
+
+    struct SearchStateHash {
+        std::size_t operator()(const SearchState& state) const;
+    };
+
+    bool Enumerate(const AIObservation& observation);
+    bool Extend(Fleet& fleet, const Bitboard& free_cells, int first, std::vector<const Placement*>& chosen);
+    bool Feasible(Fleet& fleet, const Bitboard& free_cells);
+
+    // Ожидаемое число выстрелов по неподбитым клеткам, если верна одна из расстановок layouts,
+    // а в сжатых клетках hits уже попали. При нехватке бюджета exhausted_ = true.
+    double Expected(std::uint64_t layouts, std::uint64_t hits, int* best_cell);
+    bool Spend();
+    std::size_t MaxLayouts() const;
+
+    static int LargestSize(const Fleet& fleet);
+    static std::uint32_t PackedCounts(const Fleet& fleet);
+
+    EndgameSettings settings_;
+    std::array<const PlacementIndex*, Ship::kMaxSize + 1> indexes_{};
+    std::array<std::vector<int>, Ship::kMaxSize + 1> valid_;
+    Bitboard open_hits_;
+
+    std::vector<std::vector<const Placement*>> found_;
+    std::vector<Layout> layouts_;
+    std::vector<int> cells_;
+    std::unordered_map<FleetState, bool, FleetStateHash> feasible_;
+    std::unordered_map<SearchState, double, SearchStateHash> expected_;
+
+    std::size_t nodes_ = 0;
+    Deadline deadline_ = Deadline::max();
+    bool exhausted_ = false;
+    double expected_shots_ = 0.0;
+    int layout_count_ = 0;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "FleetFeasibility.h"
+#include <array>
+#include "FleetPlacer.h"
+#include "Ship.h"
+
+
+
+namespace {
+
+constexpr int kTableMinSide = 10;
+constexpr int kTableMaxSide = 14;
+constexpr int kTableMaxShips = 16;
+
+// Флот, который не помещается на квадратное поле field_size, хотя без любого его корабля
+// уже помещается. counts[size - 1] — число кораблей размера size.
+struct MinimalMisfit {
+    int field_size;
+    std::array<int, Ship::kMaxSize> counts;
+};
+
+// Посчитано FleetPlacer без ограничения перебора для всех флотов до 16 кораблей.
+// Убирая корабль из флота, его нельзя сделать непомещающимся, поэтому флот не помещается
+// ровно тогда, когда кораблей каждого размера в нём не меньше, чем в одной из строк таблицы.
+// На полях 12–14 помещается любой такой флот.
+constexpr MinimalMisfit kMinimalMisfits[] = {
+    {10, {6, 0, 10, 0}}, {10, {5, 1, 10, 0}}, {10, {4, 2, 10, 0}}, {10, {3, 3, 10, 0}}, {10, {2, 4, 10, 0}},
+    {10, {1, 5, 10, 0}}, {10, {0, 6, 10, 0}}, {10, {4, 0, 11, 0}}, {10, {3, 1, 11, 0}}, {10, {2, 2, 11, 0}},
+    {10, {1, 3, 11, 0}}, {10, {0, 4, 11, 0}}, {10, {2, 0, 12, 0}}, {10, {1, 1, 12, 0}}, {10, {0, 2, 12, 0}},
+    {10, {0, 0, 13, 0}}, {10, {6, 0, 9, 1}}, {10, {5, 1, 9, 1}}, {10, {4, 2, 9, 1}}, {10, {3, 3, 9, 1}},
+    {10, {2, 4, 9, 1}}, {10, {1, 5, 9, 1}}, {10, {0, 6, 9, 1}}, {10, {4, 0, 10, 1}}, {10, {3, 1, 10, 1}},
+    {10, {2, 2, 10, 1}}, {10, {1, 3, 10, 1}}, {10, {0, 4, 10, 1}}, {10, {2, 0, 11, 1}}, {10, {1, 1, 11, 1}},
+    {10, {0, 2, 11, 1}}, {10, {0, 0, 12, 1}}, {10, {6, 0, 8, 2}}, {10, {5, 1, 8, 2}}, {10, {4, 2, 8, 2}},
+    {10, {3, 3, 8, 2}}, {10, {2, 4, 8, 2}}, {10, {1, 5, 8, 2}}, {10, {0, 6, 8, 2}}, {10, {4, 0, 9, 2}},
+    {10, {3, 1, 9, 2}}, {10, {2, 2, 9, 2}}, {10, {1, 3, 9, 2}}, {10, {0, 4, 9, 2}}, {10, {2, 0, 10, 2}},
+    {10, {1, 1, 10, 2}}, {10, {0, 2, 10, 2}}, {10, {0, 0, 11, 2}}, {10, {6, 0, 7, 3}}, {10, {5, 1, 7, 3}},
+    {10, {4, 2, 7, 3}}, {10, {3, 3, 7, 3}}, {10, {2, 4, 7, 3}}, {10, {1, 5, 7, 3}}, {10, {0, 6, 7, 3}},
+    {10, {4, 0, 8, 3}}, {10, {3, 1, 8, 3}}, {10, {2, 2, 8, 3}}, {10, {1, 3, 8, 3}}, {10, {0, 4, 8, 3}},
+    {10, {2, 0, 9, 3}}, {10, {1, 1, 9, 3}}, {10, {0, 2, 9, 3}}, {10, {0, 0, 10, 3}}, {10, {0, 7, 5, 4}},
+    {10, {6, 0, 6, 4}}, {10, {5, 1, 6, 4}}, {10, {4, 2, 6, 4}}, {10, {3, 3, 6, 4}}, {10, {2, 4, 6, 4}},
+    {10, {1, 5, 6, 4}}, {10, {0, 6, 6, 4}}, {10, {4, 0, 7, 4}}, {10, {3, 1, 7, 4}}, {10, {2, 2, 7, 4}},
+    {10, {1, 3, 7, 4}}, {10, {0, 4, 7, 4}}, {10, {2, 0, 8, 4}}, {10, {1, 1, 8, 4}}, {10, {0, 2, 8, 4}},
+    {10, {0, 0, 9, 4}}, {10, {0, 8, 3, 5}}, {10, {1, 6, 4, 5}}, {10, {0, 7, 4, 5}}, {10, {6, 0, 5, 5}},
+    {10, {5, 1, 5, 5}}, {10, {4, 2, 5, 5}}, {10, {3, 3, 5, 5}}, {10, {2, 4, 5, 5}}, {10, {1, 5, 5, 5}},
+    {10, {0, 6, 5, 5}}, {10, {4, 0, 6, 5}}, {10, {3, 1, 6, 5}}, {10, {2, 2, 6, 5}}, {10, {1, 3, 6, 5}},
+    {10, {0, 4, 6, 5}}, {10, {2, 0, 7, 5}}, {10, {1, 1, 7, 5}}, {10, {0, 2, 7, 5}}, {10, {0, 0, 8, 5}},
+    {10, {0, 9, 1, 6}}, {10, {1, 7, 2, 6}}, {10, {0, 8, 2, 6}}, {10, {2, 5, 3, 6}}, {10, {1, 6, 3, 6}},
+    {10, {0, 7, 3, 6}}, {10, {6, 0, 4, 6}}, {10, {5, 1, 4, 6}}, {10, {4, 2, 4, 6}}, {10, {3, 3, 4, 6}},
+    {10, {2, 4, 4, 6}}, {10, {0, 5, 4, 6}}, {10, {4, 0, 5, 6}}, {10, {3, 1, 5, 6}}, {10, {2, 2, 5, 6}},
+    {10, {1, 3, 5, 6}}, {10, {0, 4, 5, 6}}, {10, {2, 0, 6, 6}}, {10, {1, 1, 6, 6}}, {10, {0, 2, 6, 6}},
+    {10, {0, 0, 7, 6}}, {10, {1, 8, 0, 7}}, {10, {0, 9, 0, 7}}, {10, {2, 6, 1, 7}}, {10, {1, 7, 1, 7}},
+    {10, {0, 8, 1, 7}}, {10, {3, 4, 2, 7}}, {10, {2, 5, 2, 7}}, {10, {0, 6, 2, 7}}, {10, {6, 0, 3, 7}},
+    {10, {5, 1, 3, 7}}, {10, {4, 2, 3, 7}}, {10, {3, 3, 3, 7}}, {10, {1, 4, 3, 7}}, {10, {0, 5, 3, 7}},
+    {10, {4, 0, 4, 7}}, {10, {3, 1, 4, 7}}, {10, {2, 2, 4, 7}}, {10, {1, 3, 4, 7}}, {10, {0, 4, 4, 7}},
+    {10, {2, 0, 5, 7}}, {10, {1, 1, 5, 7}}, {10, {0, 2, 5, 7}}, {10, {0, 0, 6, 7}}, {10, {3, 5, 0, 8}},
+    {10, {2, 6, 0, 8}}, {10, {0, 7, 0, 8}}, {10, {4, 3, 1, 8}}, {10, {3, 4, 1, 8}}, {10, {1, 5, 1, 8}},
+    {10, {0, 6, 1, 8}}, {10, {6, 0, 2, 8}}, {10, {5, 1, 2, 8}}, {10, {4, 2, 2, 8}}, {10, {2, 3, 2, 8}},
+    {10, {1, 4, 2, 8}}, {10, {0, 5, 2, 8}}, {10, {4, 0, 3, 8}}, {10, {3, 1, 3, 8}}, {10, {2, 2, 3, 8}},
+    {10, {0, 3, 3, 8}}, {10, {2, 0, 4, 8}}, {10, {1, 1, 4, 8}}, {10, {0, 2, 4, 8}}, {10, {0, 0, 5, 8}},
+    {10, {5, 2, 0, 9}}, {10, {4, 3, 0, 9}}, {10, {2, 4, 0, 9}}, {10, {1, 5, 0, 9}}, {10, {0, 6, 0, 9}},
+    {10, {6, 0, 1, 9}}, {10, {5, 1, 1, 9}}, {10, {3, 2, 1, 9}}, {10, {2, 3, 1, 9}}, {10, {0, 4, 1, 9}},
+    {10, {4, 0, 2, 9}}, {10, {3, 1, 2, 9}}, {10, {1, 2, 2, 9}}, {10, {0, 3, 2, 9}}, {10, {2, 0, 3, 9}},
+    {10, {1, 1, 3, 9}}, {10, {0, 2, 3, 9}}, {10, {0, 0, 4, 9}}, {10, {6, 0, 0, 10}}, {10, {4, 1, 0, 10}},
+    {10, {3, 2, 0, 10}}, {10, {1, 3, 0, 10}}, {10, {0, 4, 0, 10}}, {10, {4, 0, 1, 10}}, {10, {2, 1, 1, 10}},
+    {10, {1, 2, 1, 10}}, {10, {0, 3, 1, 10}}, {10, {2, 0, 2, 10}}, {10, {0, 1, 2, 10}}, {10, {0, 0, 3, 10}},
+    {10, {3, 0, 0, 11}}, {10, {2, 1, 0, 11}}, {10, {0, 2, 0, 11}}, {10, {1, 0, 1, 11}}, {10, {0, 1, 1, 11}},
+    {10, {0, 0, 2, 11}}, {10, {1, 0, 0, 12}}, {10, {0, 1, 0, 12}}, {10, {0, 0, 1, 12}}, {10, {0, 0, 0, 13}},
+    {11, {0, 0, 7, 9}}, {11, {0, 1, 5, 10}}, {11, {0, 0, 6, 10}}, {11, {0, 2, 3, 11}}, {11, {1, 0, 4, 11}},
+    {11, {0, 1, 4, 11}}, {11, {0, 0, 5, 11}}, {11, {0, 3, 1, 12}}, {11, {1, 1, 2, 12}}, {11, {0, 2, 2, 12}},
+    {11, {1, 0, 3, 12}}, {11, {0, 1, 3, 12}}, {11, {0, 0, 4, 12}}, {11, {1, 2, 0, 13}}, {11, {0, 3, 0, 13}},
+    {11, {2, 0, 1, 13}}, {11, {1, 1, 1, 13}}, {11, {0, 2, 1, 13}}, {11, {0, 0, 2, 13}}, {11, {2, 0, 0, 14}},
+    {11, {0, 1, 0, 14}}, {11, {0, 0, 1, 14}}, {11, {0, 0, 0, 15}},
+};
+
+
+bool MatchesMisfitTable(int field_size, const std::array<int, Ship::kMaxSize + 1>& counts) {
+    for (const MinimalMisfit& misfit : kMinimalMisfits) {
+        if (misfit.field_size != field_size) continue;
+        bool covers = true;
+        for (int size = 1; size <= Ship::kMaxSize && covers; ++size) {
+            covers = counts[size] >= misfit.counts[size - 1];
+        }
+        if (covers) return true;
+    }
+    return false;
+}
+
+}
+
+
+FleetFeasibility& FleetFeasibility::getInstance() {
+    static FleetFeasibility instance;
+    return instance;
+}
+
+
+FleetFit FleetFeasibility::Check(int x_size, int y_size, const std::vector<int>& sizes) {
+    if (x_size < 1 || y_size < 1 || x_size > Bitboard::kMaxSide || y_size > Bitboard::kMaxSide) {
+        return FleetFit::DOES_NOT_FIT;
+    }
+    if (sizes.empty()) return FleetFit::FITS;
+
+    std::array<int, Ship::kMaxSize + 1> counts{};
+    for (int size : sizes) {
+        if (size < 1 || size > Ship::kMaxSize) return FleetFit::DOES_NOT_FIT;
+        counts[size]++;
+    }
+    if (!FleetPlacer::PassesAreaBound(x_size, y_size, sizes)) return FleetFit::DOES_NOT_FIT;
+
+    const int ship_count = static_cast<int>(sizes.size());
+    if (x_size == y_size && x_size >= kTableMinSide && x_size <= kTableMaxSide && ship_count <= kTableMaxShips) {
+        return MatchesMisfitTable(x_size, counts) ? FleetFit::DOES_NOT_FIT : FleetFit::FITS;
+    }
+
+    // После проверки площади кораблей каждого размера заведомо меньше 2^12.
+    std::uint64_t key = (static_cast<std::uint64_t>(x_size) << 8) | static_cast<std::uint64_t>(y_size);
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        key = (key << 12) | static_cast<std::uint64_t>(counts[size]);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(key);
+        if (it != cache_.end()) return it->second;
+    }
+
+    // Перебор идёт без блокировки: если два потока спросят одно и то же, ответ просто посчитается дважды.
+    Rng gen(key);
+    std::vector<ShipPlacement> layout;
+    FleetFit fit = FleetFit::UNKNOWN;
+    switch (FleetPlacer(x_size, y_size).Place(sizes, gen, layout)) {
+        case FleetSearchResult::FOUND:            fit = FleetFit::FITS; break;
+        case FleetSearchResult::IMPOSSIBLE:       fit = FleetFit::DOES_NOT_FIT; break;
+        case FleetSearchResult::BUDGET_EXHAUSTED: fit = FleetFit::UNKNOWN; break;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.emplace(key, fit);
+    return fit;
+}
+
+
+std::size_t FleetFeasibility::cached_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+}
@@ -0,0 +1,37 @@
+#ifndef BATTLESHIP_CORE_FLEETFEASIBILITY_H_
+#define BATTLESHIP_CORE_FLEETFEASIBILITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum class FleetFit {
+    FITS,
+    DOES_NOT_FIT,
+    UNKNOWN
+};
+
+// Ответ на вопрос «помещается ли флот на поле?» для диалогов настройки.
+//
+// Порядок кораблей не важен, поэтому ключ — размер поля и число кораблей каждого размера.
+// Для квадратных полей 10–14 и флотов до 16 кораблей ответ берётся из заранее посчитанной
+// таблицы, остальные запросы один раз решаются FleetPlacer и запоминаются.
+// UNKNOWN означает, что перебор не уложился в бюджет и ответ не доказан.
+class FleetFeasibility {
+public:
+    static FleetFeasibility& getInstance();
+
+    FleetFit Check(int x_size, int y_size, const std::vector<int>& sizes);
+
+    std::size_t cached_count() const;
+
+private:
+    FleetFeasibility() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::uint64_t, FleetFit> cache_;
+};
+
+#endif
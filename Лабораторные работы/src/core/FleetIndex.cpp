@@ -0,0 +1,76 @@
+#include "FleetIndex.h"
+
+
+FleetIndex::FleetIndex() : alive_ships_(0), remaining_segments_(0) {
+    alive_by_size_.fill(0);
+}
+
+
+void FleetIndex::Clear() {
+    alive_by_size_.fill(0);
+    alive_ships_ = 0;
+    remaining_segments_ = 0;
+    index_by_number_.clear();
+}
+
+
+void FleetIndex::AddShip(const Ship& ship, int index) {
+    const int number = ship.ship_number();
+    if (number >= 0) {
+        if (static_cast<size_t>(number) >= index_by_number_.size()) {
+            index_by_number_.resize(number + 1, -1);
+        }
+        index_by_number_[number] = index;
+    }
+    if (!ship.IsDestroyed()) {
+        alive_by_size_[ship.ship_size()]++;
+        alive_ships_++;
+        remaining_segments_ += ship.alive_segments();
+    }
+}
+
+
+void FleetIndex::RemoveShip(const Ship& ship) {
+    const int number = ship.ship_number();
+    if (number >= 0 && static_cast<size_t>(number) < index_by_number_.size()) {
+        index_by_number_[number] = -1;
+    }
+    if (!ship.IsDestroyed()) {
+        alive_by_size_[ship.ship_size()]--;
+        alive_ships_--;
+        remaining_segments_ -= ship.alive_segments();
+    }
+}
+
+
+void FleetIndex::OnSegmentsLost(int count) {
+    remaining_segments_ -= count;
+}
+
+
+void FleetIndex::OnShipDestroyed(const Ship& ship) {
+    alive_by_size_[ship.ship_size()]--;
+    alive_ships_--;
+}
+
+
+int FleetIndex::alive_ships() const {
+    return alive_ships_;
+}
+
+
+int FleetIndex::alive_ships_of_size(int size) const {
+    if (size < 1 || size > Ship::kMaxSize) return 0;
+    return alive_by_size_[size];
+}
+
+
+int FleetIndex::remaining_segments() const {
+    return remaining_segments_;
+}
+
+
+int FleetIndex::ship_index_by_number(int number) const {
+    if (number < 0 || static_cast<size_t>(number) >= index_by_number_.size()) return -1;
+    return index_by_number_[number];
+}
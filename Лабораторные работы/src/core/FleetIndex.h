@@ -0,0 +1,33 @@
+#ifndef BATTLESHIP_CORE_FLEETINDEX_H_
+#define BATTLESHIP_CORE_FLEETINDEX_H_
+
+#include <array>
+#include <vector>
+#include "Ship.h"
+
+// Сводка по флоту поля, которая обновляется при каждом изменении кораблей,
+// чтобы вопросы «сколько осталось» и «где корабль с номером N» решались за O(1).
+class FleetIndex {
+public:
+    FleetIndex();
+
+    void Clear();
+
+    void AddShip(const Ship& ship, int index);
+    void RemoveShip(const Ship& ship);
+    void OnSegmentsLost(int count);
+    void OnShipDestroyed(const Ship& ship);
+
+    int alive_ships() const;
+    int alive_ships_of_size(int size) const;
+    int remaining_segments() const;
+    int ship_index_by_number(int number) const;
+
+private:
+    std::array<int, Ship::kMaxSize + 1> alive_by_size_;
+    int alive_ships_;
+    int remaining_segments_;
+    std::vector<int> index_by_number_;
+};
+
+#endif
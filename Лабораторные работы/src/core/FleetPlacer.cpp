@@ -0,0 +1,271 @@
+#include "FleetPlacer.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+
+
+
+namespace {
+
+// Состояние, из которого уже не удалось расставить оставшиеся корабли:
+// закрытые клетки расширенного поля и число оставшихся кораблей каждого размера.
+struct FailedState {
+    Bitboard covered;
+    std::uint32_t counts;
+
+    bool operator==(const FailedState& other) const {
+        return counts == other.counts && covered == other.covered;
+    }
+};
+
+struct FailedStateHash {
+    std::size_t operator()(const FailedState& state) const {
+        std::uint64_t hash = 1469598103934665603ull ^ state.counts;
+        for (int i = 0; i < Bitboard::kWords; ++i) {
+            hash = (hash ^ state.covered.word(i)) * 1099511628211ull;
+            hash ^= hash >> 29;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+
+struct Option {
+    int size;
+    Orientation orientation;
+};
+
+int RectWidth(int size, Orientation orientation) {
+    return (orientation == Orientation::HORIZONTAL) ? size + 1 : 2;
+}
+
+int RectHeight(int size, Orientation orientation) {
+    return (orientation == Orientation::VERTICAL) ? size + 1 : 2;
+}
+
+// Клетки, в которые можно поставить угол прямоугольника w x h целиком внутри free.
+// Результат нужно ограничить допустимыми углами: сдвиг вправо переносит биты между строками.
+Bitboard Erode(const Bitboard& free_cells, int w, int h) {
+    Bitboard row = free_cells;
+    for (int k = 1; k < w; ++k) row &= free_cells >> k;
+    Bitboard rect = row;
+    for (int k = 1; k < h; ++k) rect &= row >> (k * Bitboard::kStride);
+    return rect;
+}
+
+// Все клетки, которые накрывают прямоугольники w x h с углами в anchors.
+Bitboard Dilate(const Bitboard& anchors, int w, int h) {
+    Bitboard column = anchors;
+    for (int k = 1; k < h; ++k) column |= anchors << (k * Bitboard::kStride);
+    Bitboard rect = column;
+    for (int k = 1; k < w; ++k) rect |= column << k;
+    return rect;
+}
+
+}
+
+
+struct FleetPlacer::SearchContext {
+    Rng* gen = nullptr;
+    std::array<int, Ship::kMaxSize + 1> left{};
+    int ships_left = 0;
+    std::vector<ShipPlacement> chosen;
+    std::unordered_set<FailedState, FailedStateHash> failed;
+    std::size_t nodes = 0;
+    std::size_t budget = 0;
+    bool exhausted = false;
+
+    std::uint32_t PackedCounts() const {
+        std::uint32_t packed = 0;
+        for (int size = 1; size <= Ship::kMaxSize; ++size) packed = (packed << 8) | static_cast<std::uint32_t>(left[size]);
+        return packed;
+    }
+};
+
+
+FleetPlacer::FleetPlacer(int x_size, int y_size)
+        : x_size_(x_size), y_size_(y_size), expanded_board_(BoardMask(x_size + 1, y_size + 1)) {
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        for (Orientation orientation : {Orientation::HORIZONTAL, Orientation::VERTICAL}) {
+            const int w = RectWidth(size, orientation);
+            const int h = RectHeight(size, orientation);
+            Bitboard& rect = rects_[size][static_cast<int>(orientation)];
+            Bitboard& anchors = anchors_[size][static_cast<int>(orientation)];
+            for (int dy = 0; dy < h; ++dy) {
+                for (int dx = 0; dx < w; ++dx) rect.Set(dx, dy);
+            }
+            for (int y = 0; y + h <= y_size_ + 1; ++y) {
+                for (int x = 0; x + w <= x_size_ + 1; ++x) anchors.Set(x, y);
+            }
+        }
+    }
+}
+
+
+FleetSearchResult FleetPlacer::Place(const std::vector<int>& sizes, Rng& gen,
+                                     std::vector<ShipPlacement>& layout,
+                                     const Bitboard& occupied, std::size_t node_budget) const {
+    layout.clear();
+
+    SearchContext ctx;
+    int area = 0;
+    for (int size : sizes) {
+        if (size < 1 || size > Ship::kMaxSize) return FleetSearchResult::IMPOSSIBLE;
+        ctx.left[size]++;
+        area += 2 * (size + 1);
+    }
+    ctx.ships_left = static_cast<int>(sizes.size());
+    ctx.gen = &gen;
+    ctx.budget = node_budget;
+
+    // Уже стоящие корабли закрывают свои прямоугольники: клетку, соседа справа, снизу и по диагонали.
+    const Bitboard covered = (occupied | (occupied << 1) | (occupied << Bitboard::kStride) |
+                              (occupied << (Bitboard::kStride + 1))) & expanded_board_;
+    const int slack = expanded_board_.Count() - covered.Count() - area;
+    if (slack < 0) {
+        return FleetSearchResult::IMPOSSIBLE;
+    }
+
+    if (!Search(ctx, covered, slack)) {
+        return ctx.exhausted ? FleetSearchResult::BUDGET_EXHAUSTED : FleetSearchResult::IMPOSSIBLE;
+    }
+
+    // Перебор идёт сверху вниз, поэтому раскладка ещё и отражается случайным образом.
+    if (!occupied.Any()) {
+        ApplyRandomSymmetry(ctx.chosen, gen);
+    }
+
+    // Найденные позиции раздаются кораблям нужного размера в исходном порядке.
+    std::shuffle(ctx.chosen.begin(), ctx.chosen.end(), gen);
+    layout.resize(sizes.size());
+    std::vector<bool> used(ctx.chosen.size(), false);
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        for (std::size_t j = 0; j < ctx.chosen.size(); ++j) {
+            if (!used[j] && ctx.chosen[j].size == sizes[i]) {
+                used[j] = true;
+                layout[i] = ctx.chosen[j];
+                break;
+            }
+        }
+    }
+    return FleetSearchResult::FOUND;
+}
+
+
+bool FleetPlacer::Search(SearchContext& ctx, const Bitboard& covered, int slack) const {
+    if (ctx.ships_left == 0) return true;
+    if (++ctx.nodes > ctx.budget) {
+        ctx.exhausted = true;
+        return false;
+    }
+
+    const FailedState key{covered, ctx.PackedCounts()};
+    if (ctx.failed.count(key) != 0) return false;
+
+    const Bitboard free_cells = expanded_board_.AndNot(covered);
+    const int cell = free_cells.FirstSet();
+    const int x = cell % Bitboard::kStride;
+    const int y = cell / Bitboard::kStride;
+
+    // Для каждого оставшегося корабля ищем, куда его ещё можно поставить. Если какой-то
+    // корабль уже некуда деть или клеток, которые ничем не накрыть, больше запаса, ветвь пуста.
+    // Первую свободную клетку можно закрыть углом прямоугольника любого подходящего корабля.
+    std::array<Option, 2 * Ship::kMaxSize> options;
+    int option_count = 0;
+    Bitboard coverable;
+    bool dead_end = false;
+    for (int size = 1; size <= Ship::kMaxSize && !dead_end; ++size) {
+        if (ctx.left[size] == 0) continue;
+        bool fits_somewhere = false;
+        for (Orientation orientation : {Orientation::HORIZONTAL, Orientation::VERTICAL}) {
+            if (size == 1 && orientation == Orientation::VERTICAL) continue;
+            const int w = RectWidth(size, orientation);
+            const int h = RectHeight(size, orientation);
+            const Bitboard fits = Erode(free_cells, w, h) & anchors_[size][static_cast<int>(orientation)];
+            if (!fits.Any()) continue;
+            fits_somewhere = true;
+            coverable |= Dilate(fits, w, h);
+            if (fits.Test(x, y)) options[option_count++] = Option{size, orientation};
+        }
+        dead_end = !fits_somewhere;
+    }
+    if (dead_end || free_cells.AndNot(coverable).Count() > slack) {
+        ctx.failed.insert(key);
+        return false;
+    }
+    std::shuffle(options.begin(), options.begin() + option_count, *ctx.gen);
+
+    // Клетку можно и оставить пустой, пока хватает запаса. Чем больше доля запаса
+    // среди свободных клеток, тем чаще этот вариант пробуется первым.
+    bool skip_first = false;
+    if (slack > 0) {
+        std::uniform_int_distribution<int> dist(1, free_cells.Count());
+        skip_first = dist(*ctx.gen) <= slack;
+    }
+
+    Bitboard skipped = covered;
+    skipped.Set(x, y);
+    if (skip_first && Search(ctx, skipped, slack - 1)) return true;
+    if (ctx.exhausted) return false;
+
+    for (int i = 0; i < option_count; ++i) {
+        const Option& option = options[i];
+        ctx.left[option.size]--;
+        ctx.ships_left--;
+        ctx.chosen.push_back(ShipPlacement{x, y, option.size, option.orientation});
+        if (Search(ctx, covered | (rects_[option.size][static_cast<int>(option.orientation)] << cell), slack)) {
+            return true;
+        }
+        ctx.chosen.pop_back();
+        ctx.ships_left++;
+        ctx.left[option.size]++;
+        if (ctx.exhausted) return false;
+    }
+
+    if (!skip_first && slack > 0) {
+        if (Search(ctx, skipped, slack - 1)) return true;
+        if (ctx.exhausted) return false;
+    }
+
+    ctx.failed.insert(key);
+    return false;
+}
+
+
+void FleetPlacer::ApplyRandomSymmetry(std::vector<ShipPlacement>& placements, Rng& gen) const {
+    std::uniform_int_distribution<int> coin(0, 1);
+    const bool flip_x = coin(gen) == 1;
+    const bool flip_y = coin(gen) == 1;
+    const bool transpose = x_size_ == y_size_ && coin(gen) == 1;
+
+    for (ShipPlacement& p : placements) {
+        const int w = (p.orientation == Orientation::HORIZONTAL) ? p.size : 1;
+        const int h = (p.orientation == Orientation::VERTICAL) ? p.size : 1;
+        if (flip_x) p.x = x_size_ - p.x - w;
+        if (flip_y) p.y = y_size_ - p.y - h;
+        if (transpose) {
+            std::swap(p.x, p.y);
+            if (p.size > 1) {
+                p.orientation = (p.orientation == Orientation::HORIZONTAL) ? Orientation::VERTICAL
+                                                                            : Orientation::HORIZONTAL;
+            }
+        }
+    }
+}
+
+
+bool FleetPlacer::PassesAreaBound(int x_size, int y_size, const std::vector<int>& sizes) {
+    int area = 0;
+    for (int size : sizes) area += 2 * (size + 1);
+    return area <= (x_size + 1) * (y_size + 1);
+}
+
+
+int FleetPlacer::x_size() const {
+    return x_size_;
+}
+
+
+int FleetPlacer::y_size() const {
+    return y_size_;
+}
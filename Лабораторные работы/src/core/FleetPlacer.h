@@ -0,0 +1,68 @@
+#ifndef BATTLESHIP_CORE_FLEETPLACER_H_
+#define BATTLESHIP_CORE_FLEETPLACER_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "Bitboard.h"
+#include "Random.h"
+#include "Ship.h"
+
+enum class FleetSearchResult {
+    FOUND,
+    IMPOSSIBLE,
+    BUDGET_EXHAUSTED
+};
+
+struct ShipPlacement {
+    int x;
+    int y;
+    int size;
+    Orientation orientation;
+};
+
+// Точная расстановка флота перебором с возвратами.
+//
+// Корабль вместе с клетками справа и снизу занимает прямоугольник 2 x (size + 1) на поле
+// (x + 1) x (y + 1), и корабли не касаются друг друга ровно тогда, когда эти прямоугольники
+// не пересекаются. Поэтому расстановка — это укладка прямоугольников: перебор всегда
+// закрывает первую свободную клетку (углом очередного прямоугольника или оставляя её пустой),
+// а число клеток, которые ещё можно оставить пустыми, сразу отсекает безнадёжные ветви.
+// Порядок вариантов случайный, поэтому раскладки получаются разными; если расстановки нет,
+// перебор доказывает это, а не сдаётся после N случайных попыток.
+class FleetPlacer {
+public:
+    static constexpr std::size_t kDefaultNodeBudget = 200000;
+
+    FleetPlacer(int x_size, int y_size);
+
+    // Расставляет корабли sizes на поле, где уже стоят корабли occupied.
+    // В layout возвращается позиция для каждого корабля в порядке sizes.
+    FleetSearchResult Place(const std::vector<int>& sizes, Rng& gen,
+                            std::vector<ShipPlacement>& layout,
+                            const Bitboard& occupied = Bitboard(),
+                            std::size_t node_budget = kDefaultNodeBudget) const;
+
+    // Необходимое условие: сумма площадей прямоугольников не больше площади поля (x + 1) x (y + 1).
+    static bool PassesAreaBound(int x_size, int y_size, const std::vector<int>& sizes);
+
+    int x_size() const;
+    int y_size() const;
+
+private:
+    struct SearchContext;
+
+    bool Search(SearchContext& ctx, const Bitboard& covered, int slack) const;
+    void ApplyRandomSymmetry(std::vector<ShipPlacement>& placements, Rng& gen) const;
+
+    int x_size_;
+    int y_size_;
+    // Клетки расширенного поля (x_size_ + 1) x (y_size_ + 1).
+    Bitboard expanded_board_;
+    // Прямоугольник корабля с углом в (0, 0) для каждого размера и ориентации
+    // и клетки, в которые можно поставить угол так, чтобы прямоугольник не вышел за поле.
+    std::array<std::array<Bitboard, 2>, Ship::kMaxSize + 1> rects_;
+    std::array<std::array<Bitboard, 2>, Ship::kMaxSize + 1> anchors_;
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "LayoutPool.h"
+#include <algorithm>
+#include <functional>
+#include "LayoutSampler.h"
+#include "PlacementIndex.h"
+
+
+
+LayoutPool& LayoutPool::getInstance() {
+    static LayoutPool instance;
+    return instance;
+}
+
+
+LayoutPool::LayoutPool() {
+    // Фоновый поток пользуется индексом позиций; индекс создаётся раньше пула,
+    // поэтому и разрушится только после того, как поток будет остановлен.
+    PlacementIndex::Get(1, 1, 1);
+}
+
+
+LayoutPool::~LayoutPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+
+void LayoutPool::Configure(const LayoutPoolSettings& settings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_ = settings;
+    settings_.capacity = std::max<std::size_t>(settings_.capacity, 1);
+    settings_.refill_threshold = std::min(settings_.refill_threshold, settings_.capacity - 1);
+    for (auto& [key, entry] : entries_) {
+        while (entry.ready.size() > settings_.capacity) entry.ready.pop_front();
+        while (entry.pending.size() > settings_.capacity) entry.pending.pop_front();
+    }
+}
+
+
+LayoutPoolSettings LayoutPool::settings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return settings_;
+}
+
+
+std::uint64_t LayoutPool::NextSeed(Rng& rng) {
+    return rng();
+}
+
+
+void LayoutPool::Prefetch(int x_size, int y_size, const std::vector<int>& sizes, const Rng& rng,
+                          std::size_t node_budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = EntryFor(MakeKey(x_size, y_size, sizes, node_budget));
+    if (entry.failed || entry.sizes.empty()) {
+        return;
+    }
+
+    // Поток не трогается: зёрна следующих расстановок берутся из копии.
+    Rng ahead = rng;
+    std::vector<std::uint64_t> seeds(settings_.capacity);
+    std::size_t covered = 0;
+    for (std::uint64_t& seed : seeds) {
+        seed = NextSeed(ahead);
+        if (Has(entry, seed)) ++covered;
+    }
+    if (covered > settings_.refill_threshold) {
+        return;
+    }
+
+    for (std::uint64_t seed : seeds) {
+        if (!Has(entry, seed)) entry.pending.push_back(seed);
+    }
+    while (entry.pending.size() > settings_.capacity) entry.pending.pop_front();
+    WakeWorker();
+}
+
+
+bool LayoutPool::Take(int x_size, int y_size, const std::vector<int>& sizes, std::uint64_t seed,
+                      std::vector<ShipPlacement>& layout, std::size_t node_budget) {
+    std::vector<ShipPlacement> stored;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = EntryFor(MakeKey(x_size, y_size, sizes, node_budget));
+        auto it = std::find_if(entry.ready.begin(), entry.ready.end(),
+                               [seed](const auto& item) { return item.first == seed; });
+        if (it != entry.ready.end()) {
+            stored = std::move(it->second);
+            entry.ready.erase(it);
+        } else {
+            // Расстановку построят на месте: заказ снимается, а уже начатую поток выбросит.
+            entry.pending.erase(std::remove(entry.pending.begin(), entry.pending.end(), seed),
+                                entry.pending.end());
+            if (entry.in_flight == seed) entry.in_flight.reset();
+        }
+    }
+    if (stored.empty()) {
+        return false;
+    }
+
+    // Позиции хранятся по убыванию размеров; корабли одного размера взаимозаменяемы.
+    layout.assign(sizes.size(), ShipPlacement{});
+    std::vector<bool> used(stored.size(), false);
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        for (std::size_t j = 0; j < stored.size(); ++j) {
+            if (!used[j] && stored[j].size == sizes[i]) {
+                used[j] = true;
+                layout[i] = stored[j];
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+
+std::size_t LayoutPool::ready_count(int x_size, int y_size, const std::vector<int>& sizes,
+                                    std::size_t node_budget) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(MakeKey(x_size, y_size, sizes, node_budget));
+    return (it == entries_.end()) ? 0 : it->second.ready.size();
+}
+
+
+LayoutPool::Key LayoutPool::MakeKey(int x_size, int y_size, const std::vector<int>& sizes,
+                                   std::size_t node_budget) {
+    std::vector<int> sorted = sizes;
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    return Key(x_size, y_size, node_budget, std::move(sorted));
+}
+
+
+LayoutPool::Entry& LayoutPool::EntryFor(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        it = entries_.emplace(key, Entry{}).first;
+        it->second.sizes = std::get<3>(key);
+    }
+    return it->second;
+}
+
+
+bool LayoutPool::Has(const Entry& entry, std::uint64_t seed) const {
+    return entry.in_flight == seed ||
+           std::find(entry.pending.begin(), entry.pending.end(), seed) != entry.pending.end() ||
+           std::any_of(entry.ready.begin(), entry.ready.end(),
+                       [seed](const auto& item) { return item.first == seed; });
+}
+
+
+void LayoutPool::WakeWorker() {
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&LayoutPool::WorkerLoop, this);
+    }
+    wake_.notify_one();
+}
+
+
+void LayoutPool::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        Key key;
+        Entry* target = nullptr;
+        wake_.wait(lock, [&] {
+            if (stop_) return true;
+            for (auto& [entry_key, entry] : entries_) {
+                if (!entry.pending.empty() && !entry.failed) {
+                    key = entry_key;
+                    target = &entry;
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (stop_) {
+            return;
+        }
+
+        // Расстановка строится без блокировки, чтобы Take не ждал фоновый поток.
+        const std::uint64_t seed = target->pending.front();
+        target->pending.pop_front();
+        target->in_flight = seed;
+        const std::vector<int> sizes = target->sizes;
+        lock.unlock();
+        Rng gen(seed);
+        std::vector<ShipPlacement> layout;
+        const bool found = GenerateFleetLayout(std::get<0>(key), std::get<1>(key), sizes, gen, layout,
+                                               Bitboard(), std::get<2>(key));
+        lock.lock();
+
+        // Элементы std::map не перемещаются, поэтому target всё ещё указывает на ту же запись.
+        const bool taken = target->in_flight != seed;
+        target->in_flight.reset();
+        if (!found) {
+            target->failed = true;
+            target->pending.clear();
+            continue;
+        }
+        if (taken) {
+            continue;
+        }
+        target->ready.emplace_back(seed, std::move(layout));
+        while (target->ready.size() > settings_.capacity) target->ready.pop_front();
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef BATTLESHIP_CORE_LAYOUTPOOL_H_
+#define BATTLESHIP_CORE_LAYOUTPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "FleetPlacer.h"
+#include "Random.h"
+
+struct LayoutPoolSettings {
+    // На сколько случайных расстановок вперёд готовить запас для одной конфигурации.
+    std::size_t capacity = 8;
+    // Пополнение начинается, когда из них готово или заказано не больше этого числа.
+    std::size_t refill_threshold = 4;
+};
+
+
+// Запас готовых расстановок флота, который пополняется в фоновом потоке.
+//
+// Конфигурация — размер поля, число кораблей каждого размера и бюджет перебора FleetPlacer,
+// с которым строится расстановка, если выборка неприменима. Каждая расстановка строится
+// из своего зерна, поэтому совпадает с той, что получилась бы на месте из того же зерна,
+// и партия с заданным зерном воспроизводится независимо от того, успел ли поток.
+// Take отдаёт готовую расстановку сразу, а если её ещё нет, возвращает false и снимает
+// заказ на это зерно; тогда расстановку нужно построить на месте. Поток запускается
+// при первом обращении и останавливается вместе с программой.
+class LayoutPool {
+public:
+    static LayoutPool& getInstance();
+
+    void Configure(const LayoutPoolSettings& settings);
+    LayoutPoolSettings settings() const;
+
+    // Зерно следующей расстановки: каждая случайная расстановка берёт из потока ровно одно число.
+    static std::uint64_t NextSeed(Rng& rng);
+
+    // Заказать расстановки для следующих capacity зёрен, которые выдаст rng.
+    void Prefetch(int x_size, int y_size, const std::vector<int>& sizes, const Rng& rng,
+                  std::size_t node_budget = FleetPlacer::kDefaultNodeBudget);
+    // Расстановка для пустого поля, построенная из зерна seed; в layout позиции идут в порядке sizes.
+    bool Take(int x_size, int y_size, const std::vector<int>& sizes, std::uint64_t seed,
+              std::vector<ShipPlacement>& layout, std::size_t node_budget = FleetPlacer::kDefaultNodeBudget);
+
+    std::size_t ready_count(int x_size, int y_size, const std::vector<int>& sizes,
+                            std::size_t node_budget = FleetPlacer::kDefaultNodeBudget) const;
+
+    LayoutPool(const LayoutPool&) = delete;
+    LayoutPool& operator=(const LayoutPool&) = delete;
+
+private:
+    using Key = std::tuple<int, int, std::size_t, std::vector<int>>;
+
+    struct Entry {
+        // Размеры кораблей по убыванию; в этом порядке хранятся позиции в готовых расстановках.
+        std::vector<int> sizes;
+        std::deque<std::pair<std::uint64_t, std::vector<ShipPlacement>>> ready;
+        // Зёрна, для которых расстановки ещё предстоит построить, в порядке заказа.
+        std::deque<std::uint64_t> pending;
+        // Зерно, которое фоновый поток строит прямо сейчас; сбрасывается, если его забрали на месте.
+        std::optional<std::uint64_t> in_flight;
+        // Флот не удалось расставить: фоновый поток больше не тратит на него время.
+        bool failed = false;
+    };
+
+    LayoutPool();
+    ~LayoutPool();
+
+    static Key MakeKey(int x_size, int y_size, const std::vector<int>& sizes, std::size_t node_budget);
+    Entry& EntryFor(const Key& key);
+    bool Has(const Entry& entry, std::uint64_t seed) const;
+    void WakeWorker();
+    void WorkerLoop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::map<Key, Entry> entries_;
+    LayoutPoolSettings settings_;
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+#endif
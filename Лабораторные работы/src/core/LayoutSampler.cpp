@@ -0,0 +1,125 @@
+#include "LayoutSampler.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include "FleetFeasibility.h"
+#include "PlacementIndex.h"
+
+
+
+namespace {
+
+// Достаточно ли часто выборка находит расстановку флота на пустом поле. Проба идёт с зерном
+// из размеров поля и флота, поэтому ответ — функция только от них; он запоминается.
+// Флот должен проходить FleetPlacer::PassesAreaBound: тогда кораблей каждого размера меньше 2^12.
+bool IsSamplingPractical(int x_size, int y_size, const std::vector<int>& sizes) {
+    std::array<int, Ship::kMaxSize + 1> counts{};
+    for (int size : sizes) counts[size]++;
+    std::uint64_t key = (static_cast<std::uint64_t>(x_size) << 8) | static_cast<std::uint64_t>(y_size);
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        key = (key << 12) | static_cast<std::uint64_t>(counts[size]);
+    }
+
+    static std::mutex mutex;
+    static std::unordered_map<std::uint64_t, bool> practical;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = practical.find(key);
+        if (it != practical.end()) return it->second;
+    }
+
+    // Проба идёт без блокировки: при одновременных запросах ответ просто посчитается дважды.
+    Rng gen(key);
+    const LayoutSampler sampler(x_size, y_size);
+    std::vector<ShipPlacement> layout;
+    // Проба останавливается, как только удачных попыток достаточно.
+    std::size_t accepted = 0;
+    for (std::size_t attempt = 0; attempt < kProbeAttempts; ++attempt) {
+        if (accepted * kMaxExpectedAttempts >= kProbeAttempts) break;
+        if (sampler.Sample(sizes, gen, layout, Bitboard(), 1)) ++accepted;
+    }
+    const bool result = accepted * kMaxExpectedAttempts >= kProbeAttempts;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    practical.emplace(key, result);
+    return result;
+}
+
+}
+
+
+LayoutSampler::LayoutSampler(int x_size, int y_size) : x_size_(x_size), y_size_(y_size) {}
+
+
+bool LayoutSampler::Sample(const std::vector<int>& sizes, Rng& gen, std::vector<ShipPlacement>& layout,
+                           const Bitboard& occupied, std::size_t attempt_budget) const {
+    layout.clear();
+    for (int size : sizes) {
+        if (size < 1 || size > Ship::kMaxSize) return false;
+    }
+
+    std::vector<int> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return sizes[a] > sizes[b]; });
+
+    std::vector<const PlacementIndex*> indexes(sizes.size());
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        indexes[i] = &PlacementIndex::Get(x_size_, y_size_, sizes[order[i]]);
+        if (indexes[i]->count() == 0) return false;
+    }
+
+    // Клетки, где новый корабль коснулся бы уже стоящего.
+    const Bitboard initial_forbidden = occupied.Dilated();
+    std::vector<const Placement*> chosen(sizes.size());
+
+    for (std::size_t attempt = 0; attempt < attempt_budget; ++attempt) {
+        Bitboard forbidden = initial_forbidden;
+        std::size_t placed = 0;
+        for (; placed < sizes.size(); ++placed) {
+            const PlacementIndex& index = *indexes[placed];
+            const Placement& placement = index[static_cast<int>(UniformBelow(gen, static_cast<std::uint32_t>(index.count())))];
+            if (placement.ship.Intersects(forbidden)) break;
+            forbidden |= placement.halo;
+            chosen[placed] = &placement;
+        }
+        if (placed < sizes.size()) continue;
+
+        layout.resize(sizes.size());
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            layout[order[i]] = ShipPlacement{chosen[i]->x, chosen[i]->y, sizes[order[i]], chosen[i]->orientation};
+        }
+        return true;
+    }
+    return false;
+}
+
+
+bool GenerateFleetLayout(int x_size, int y_size, const std::vector<int>& sizes, Rng& gen,
+                         std::vector<ShipPlacement>& layout, const Bitboard& occupied, std::size_t node_budget) {
+    // Для слишком плотного флота выборка почти не даёт удачных попыток, и тогда расстановку находит перебор.
+    if (!occupied.Any()) {
+        if (FleetFeasibility::getInstance().Check(x_size, y_size, sizes) == FleetFit::DOES_NOT_FIT) {
+            layout.clear();
+            return false;
+        }
+        if (IsSamplingPractical(x_size, y_size, sizes) && LayoutSampler(x_size, y_size).Sample(sizes, gen, layout)) {
+            return true;
+        }
+    } else if (LayoutSampler(x_size, y_size).Sample(sizes, gen, layout, occupied, kProbeAttempts)) {
+        return true;
+    }
+    return FleetPlacer(x_size, y_size).Place(sizes, gen, layout, occupied, node_budget) == FleetSearchResult::FOUND;
+}
+
+
+int LayoutSampler::x_size() const {
+    return x_size_;
+}
+
+
+int LayoutSampler::y_size() const {
+    return y_size_;
+}
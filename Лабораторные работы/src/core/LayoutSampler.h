@@ -0,0 +1,57 @@
+#ifndef BATTLESHIP_CORE_LAYOUTSAMPLER_H_
+#define BATTLESHIP_CORE_LAYOUTSAMPLER_H_
+
+#include <cstddef>
+#include <vector>
+#include "Bitboard.h"
+#include "FleetPlacer.h"
+#include "Random.h"
+
+// Равномерно случайная расстановка флота.
+//
+// Каждый корабль независимо получает равновероятную позицию из PlacementIndex, и попытка
+// принимается, только если корабли не касаются друг друга. Все допустимые расстановки
+// поэтому одинаково вероятны (корабли одного размера не различаются). Корабли выбираются
+// от больших к меньшим, чтобы неудачная попытка обрывалась как можно раньше.
+// На плотных флотах почти все попытки неудачны, поэтому их число ограничено: если
+// бюджет исчерпан, Sample возвращает false, и расстановку нужно искать FleetPlacer.
+class LayoutSampler {
+public:
+    static constexpr std::size_t kDefaultAttemptBudget = 100000;
+
+    LayoutSampler(int x_size, int y_size);
+
+    // Расставляет корабли sizes вокруг уже стоящих кораблей occupied.
+    // В layout возвращается позиция для каждого корабля в порядке sizes.
+    bool Sample(const std::vector<int>& sizes, Rng& gen, std::vector<ShipPlacement>& layout,
+                const Bitboard& occupied = Bitboard(),
+                std::size_t attempt_budget = kDefaultAttemptBudget) const;
+
+    int x_size() const;
+    int y_size() const;
+
+private:
+    int x_size_;
+    int y_size_;
+};
+
+
+// Случайная расстановка флота: равномерная выборка, а для слишком плотного флота — FleetPlacer.
+// Возвращает false, если расставить флот не удалось.
+//
+// Флот, который по FleetFeasibility не помещается, отвергается сразу. Для пустого поля доля
+// удачных попыток выборки оценивается один раз на размер поля и флот пробой из
+// kProbeAttempts попыток с постоянным зерном, так что решение не зависит от истории вызовов
+// и одно зерно всегда даёт одну расстановку. Если удачной оказывается меньше одной попытки
+// из kMaxExpectedAttempts, флот считается плотным и сразу расставляется FleetPlacer. Вокруг
+// уже стоящих кораблей выборке даётся kProbeAttempts попыток, затем тоже FleetPlacer.
+// Расстановки FleetPlacer не равномерны: случайны порядок вариантов перебора и симметрия поля,
+// но одни расстановки выпадают чаще других. Время при этом ограничено бюджетом перебора.
+constexpr std::size_t kProbeAttempts = 20000;
+constexpr std::size_t kMaxExpectedAttempts = 10000;
+
+bool GenerateFleetLayout(int x_size, int y_size, const std::vector<int>& sizes, Rng& gen,
+                         std::vector<ShipPlacement>& layout, const Bitboard& occupied = Bitboard(),
+                         std::size_t node_budget = FleetPlacer::kDefaultNodeBudget);
+
+#endif
@@ -0,0 +1,475 @@
+#include "LockstepSimulator.h"
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATTLESHIP_X86_LOCKSTEP_KERNELS 1
+#endif
+
+
+
+namespace {
+
+constexpr int kLanes = LockstepSimulator::kLanes;
+constexpr int kChunkLanes = 4;
+
+// Одно слово доски четырёх соседних дорожек: один регистр AVX2.
+// Читается прямо из массивов дорожек, поэтому может совпадать по памяти с uint64_t.
+typedef std::uint64_t LaneVector
+    __attribute__((vector_size(kChunkLanes * sizeof(std::uint64_t)), aligned(sizeof(std::uint64_t)), may_alias));
+
+inline const LaneVector* Chunk(const std::array<std::uint64_t, kLanes>& words, int chunk) {
+    return reinterpret_cast<const LaneVector*>(words.data() + chunk * kChunkLanes);
+}
+
+
+inline LaneVector* Chunk(std::array<std::uint64_t, kLanes>& words, int chunk) {
+    return reinterpret_cast<LaneVector*>(words.data() + chunk * kChunkLanes);
+}
+
+
+inline bool AnyLane(const LaneVector& v) {
+    return (v[0] | v[1] | v[2] | v[3]) != 0;
+}
+
+
+// Шаг xoshiro256** сразу для четырёх дорожек: то же, что Xoshiro256::operator(), умножения
+// на 5 и 9 записаны сдвигами.
+inline __attribute__((always_inline)) void NextRandom(std::array<std::array<std::uint64_t, kLanes>, 4>& state,
+                                                      int chunk, LaneVector& random) {
+    LaneVector s0 = *Chunk(state[0], chunk);
+    LaneVector s1 = *Chunk(state[1], chunk);
+    LaneVector s2 = *Chunk(state[2], chunk);
+    LaneVector s3 = *Chunk(state[3], chunk);
+    const LaneVector times5 = (s1 << 2) + s1;
+    const LaneVector rotated = (times5 << 7) | (times5 >> 57);
+    random = (rotated << 3) + rotated;
+    const LaneVector t = s1 << 17;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = (s3 << 45) | (s3 >> 19);
+    *Chunk(state[0], chunk) = s0;
+    *Chunk(state[1], chunk) = s1;
+    *Chunk(state[2], chunk) = s2;
+    *Chunk(state[3], chunk) = s3;
+}
+
+
+// Число единиц в каждом слове, на месте.
+inline __attribute__((always_inline)) void Popcount(LaneVector& v) {
+    v -= (v >> 1) & 0x5555555555555555ull;
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    v += v >> 8;
+    v += v >> 16;
+    v += v >> 32;
+    v &= 0x7F;
+}
+
+
+// Номер n-й (с нуля) единицы каждого слова, как NthSetBit, но без таблицы: сначала байт, где
+// накопленное число единиц превышает n, затем единица внутри байта.
+inline __attribute__((always_inline)) void SelectBit(const LaneVector& word, const LaneVector& n, LaneVector& bit) {
+    constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+    constexpr std::uint64_t kHigh = 0x8080808080808080ull;
+    LaneVector bytes = word - ((word >> 1) & 0x5555555555555555ull);
+    bytes = (bytes & 0x3333333333333333ull) + ((bytes >> 2) & 0x3333333333333333ull);
+    bytes = (bytes + (bytes >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    // В байте i — число единиц в байтах 0..i.
+    LaneVector prefix = bytes + (bytes << 8);
+    prefix += prefix << 16;
+    prefix += prefix << 32;
+    // Старший бит байта поднят, пока накоплено не больше n; таких байтов и есть номер нужного.
+    LaneVector below = (((n * kOnes) | kHigh) - prefix) & kHigh;
+    below >>= 7;
+    below += below >> 8;
+    below += below >> 16;
+    below += below >> 32;
+    const LaneVector shift = (below & 0xFF) << 3;
+    const LaneVector before = ((prefix << 8) >> shift) & 0xFF;
+    LaneVector byte = (word >> shift) & 0xFF;
+    LaneVector rest = n - before;
+    for (int i = 0; i < 7; ++i) {
+        const LaneVector more = reinterpret_cast<LaneVector>(rest != 0);
+        byte = (byte & (byte - 1) & more) | (byte & ~more);
+        rest -= more & 1;
+    }
+    const LaneVector lowest = byte & -byte;
+    bit = shift | (reinterpret_cast<LaneVector>((lowest & 0xAA) != 0) & 1) |
+          (reinterpret_cast<LaneVector>((lowest & 0xCC) != 0) & 2) |
+          (reinterpret_cast<LaneVector>((lowest & 0xF0) != 0) & 4);
+}
+
+
+
+// Позиции кораблей расстановки. Корабли не должны касаться: иначе вода вокруг потопленного
+// корабля закроет клетки соседнего, и стрелку станет некуда стрелять.
+std::vector<const Placement*> FindPlacements(int x_size, int y_size, const std::vector<ShipPlacement>& ships) {
+    if (ships.size() > 127) {
+        throw std::invalid_argument("Слишком много кораблей в расстановке");
+    }
+    std::vector<const Placement*> placements;
+    Bitboard taken;
+    for (const ShipPlacement& ship : ships) {
+        const Placement* placement = nullptr;
+        if (ship.size >= 1 && ship.size <= Ship::kMaxSize) {
+            placement = PlacementIndex::Get(x_size, y_size, ship.size).Find(ship.x, ship.y, ship.orientation);
+        }
+        if (!placement) {
+            throw std::invalid_argument("Корабль расстановки не помещается на поле");
+        }
+        if (placement->ship.Intersects(taken)) {
+            throw std::invalid_argument("Корабли расстановки пересекаются или касаются");
+        }
+        taken |= placement->halo;
+        placements.push_back(placement);
+    }
+    return placements;
+}
+
+}
+
+
+LockstepSimulator::LockstepSimulator(int x_size, int y_size, SimdKernel kernel)
+        : x_size_(x_size), y_size_(y_size),
+          words_((y_size * Bitboard::kStride + 63) / 64),
+          kernel_(kernel == SimdKernel::AVX2 && IsSimdKernelSupported(kernel) ? kernel : SimdKernel::SCALAR),
+          board_{}, lanes_{}, games_{} {
+    if (x_size < 1 || x_size > Bitboard::kMaxSide || y_size < 1 || y_size > Bitboard::kMaxSide) {
+        throw std::invalid_argument("Размер поля должен быть от 1 до " + std::to_string(Bitboard::kMaxSide));
+    }
+    const Bitboard board = BoardMask(x_size, y_size);
+    for (int w = 0; w < Bitboard::kWords; ++w) {
+        board_[w].fill(board.word(w));
+    }
+}
+
+
+void LockstepSimulator::Run(const std::vector<std::vector<ShipPlacement>>& layouts, Rng& rng,
+                            std::vector<int>& shots) {
+    if (kernel_ != SimdKernel::AVX2) {
+        shots.resize(layouts.size());
+        for (std::size_t i = 0; i < layouts.size(); ++i) {
+            shots[i] = PlayOne(layouts[i], rng);
+        }
+        return;
+    }
+    for (std::array<std::uint64_t, kLanes>& state : lanes_.rng) {
+        for (std::uint64_t& word : state) {
+            word = rng();
+        }
+    }
+    shots.assign(layouts.size(), 0);
+    std::size_t next_layout = 0;
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if (next_layout < layouts.size()) {
+            Load(lane, static_cast<int>(next_layout), layouts[next_layout]);
+            ++next_layout;
+        } else {
+            Clear(lane);
+        }
+    }
+
+    // Пустая расстановка потоплена сразу.
+    finished_ = true;
+    for (;;) {
+        if (finished_) {
+            // Дорожки с потопленным флотом отдают результат и берут следующую расстановку.
+            finished_ = false;
+            bool busy = false;
+            for (int lane = 0; lane < kLanes; ++lane) {
+                LaneGame& game = games_[lane];
+                while (game.layout >= 0 && game.ships_left == 0) {
+                    shots[game.layout] = static_cast<int>(lanes_.shots[lane]);
+                    if (next_layout < layouts.size()) {
+                        Load(lane, static_cast<int>(next_layout), layouts[next_layout]);
+                        ++next_layout;
+                    } else {
+                        Clear(lane);
+                    }
+                }
+                busy = busy || game.layout >= 0;
+            }
+            if (!busy) {
+                return;
+            }
+        }
+        Step();
+    }
+}
+
+
+SimdKernel LockstepSimulator::kernel() const {
+    return kernel_;
+}
+
+
+// Стрелок тот же, что на дорожках, и выбор клетки тот же, только партия одна и случайные
+// числа идут из общего rng.
+int LockstepSimulator::PlayOne(const std::vector<ShipPlacement>& placements, Rng& rng) const {
+    const std::vector<const Placement*> ships = FindPlacements(x_size_, y_size_, placements);
+    std::vector<int> segments_left;
+    std::array<std::int8_t, Bitboard::kWords * 64> ship_at;
+    ship_at.fill(-1);
+    Bitboard cells;
+    for (std::size_t i = 0; i < ships.size(); ++i) {
+        Bitboard rest = ships[i]->ship;
+        for (int bit = rest.FirstSet(); bit >= 0; bit = rest.FirstSet()) {
+            ship_at[bit] = static_cast<std::int8_t>(i);
+            rest.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+        }
+        cells |= ships[i]->ship;
+        segments_left.push_back(placements[i].size);
+    }
+
+    const Bitboard board = BoardMask(x_size_, y_size_);
+    Bitboard damaged, destroyed, revealed, sunk;
+    int ships_left = static_cast<int>(ships.size());
+    int shots = 0;
+    while (ships_left > 0) {
+        Bitboard candidates = damaged;
+        if (!candidates.Any()) {
+            const Bitboard open = destroyed.AndNot(sunk);
+            const Bitboard unknown = board.AndNot(revealed);
+            candidates = ((open << 1) | (open >> 1) | (open << Bitboard::kStride) | (open >> Bitboard::kStride)) & unknown;
+            if (!candidates.Any()) candidates = unknown;
+        }
+        const int count = candidates.Count();
+        if (count == 0) {
+            throw std::runtime_error("Флот не потоплен, но стрелять некуда");
+        }
+        const int bit = candidates.NthSet(static_cast<int>(UniformBelow(rng, static_cast<std::uint32_t>(count))));
+        const int x = bit % Bitboard::kStride;
+        const int y = bit / Bitboard::kStride;
+        ++shots;
+        revealed.Set(x, y);
+        if (!cells.Test(x, y)) continue;
+        if (!damaged.Test(x, y)) {
+            damaged.Set(x, y);
+            continue;
+        }
+        damaged.Reset(x, y);
+        destroyed.Set(x, y);
+        const int ship = ship_at[bit];
+        if (--segments_left[ship] == 0) {
+            revealed |= ships[ship]->halo;
+            sunk |= ships[ship]->ship;
+            --ships_left;
+        }
+    }
+    return shots;
+}
+
+
+void LockstepSimulator::Load(int lane, int layout, const std::vector<ShipPlacement>& placements) {
+    Clear(lane);
+    LaneGame& game = games_[lane];
+    game.layout = layout;
+    lanes_.busy[lane] = ~std::uint64_t{0};
+    game.ships_left = static_cast<int>(placements.size());
+    game.ships.clear();
+    game.ship_at.fill(-1);
+
+    const std::vector<const Placement*> found = FindPlacements(x_size_, y_size_, placements);
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        const Placement* placement = found[i];
+        const std::int8_t number = static_cast<std::int8_t>(game.ships.size());
+        game.ships.push_back({placement, placements[i].size});
+        for (int w = 0; w < words_; ++w) {
+            lanes_.ships[w][lane] |= placement->ship.word(w);
+        }
+        Bitboard cells = placement->ship;
+        for (int bit = cells.FirstSet(); bit >= 0; bit = cells.FirstSet()) {
+            game.ship_at[bit] = number;
+            cells.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+        }
+    }
+}
+
+
+void LockstepSimulator::Clear(int lane) {
+    for (Planes* planes : {&lanes_.ships, &lanes_.damaged, &lanes_.destroyed, &lanes_.revealed, &lanes_.sunk}) {
+        for (LaneWords& words : *planes) {
+            words[lane] = 0;
+        }
+    }
+    // Генератор дорожки не сбрасывается: следующая партия продолжает его последовательность.
+    for (LaneWords* words : {&lanes_.busy, &lanes_.shots, &lanes_.target, &lanes_.destroyed_segment}) {
+        (*words)[lane] = 0;
+    }
+    games_[lane].layout = -1;
+    games_[lane].ships_left = 0;
+}
+
+
+void LockstepSimulator::Step() {
+#ifdef BATTLESHIP_X86_LOCKSTEP_KERNELS
+    StepAvx2();
+#endif
+
+    // Уничтоженный этим выстрелом сегмент может потопить корабль.
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if (!lanes_.destroyed_segment[lane]) continue;
+        LaneGame& game = games_[lane];
+        const int ship = game.ship_at[lanes_.target[lane]];
+        if (--game.ships[ship].segments_left == 0) {
+            Sink(lane, ship);
+        }
+    }
+}
+
+
+// Кандидаты каждой дорожки: подбитые сегменты, иначе неизвестные клетки рядом с попаданиями
+// в непотопленный корабль, иначе все неизвестные клетки. Строка не переходит через границу
+// слова, поэтому по строке соседи — сдвиг на 1 в том же слове, а по столбцу соседняя строка
+// может лежать в соседнем слове. Среди кандидатов берётся случайный по Лемиру: старшие 32 бита
+// числа генератора умножаются на число кандидатов. Число слов известно при компиляции: так
+// доски четырёх дорожек на всём ходу держатся в регистрах.
+template <int kBoardWords>
+inline __attribute__((always_inline)) void LockstepSimulator::StepBody() {
+    LaneVector stuck = {};
+    for (int chunk = 0; chunk < kLanes / kChunkLanes; ++chunk) {
+        const LaneVector busy = *Chunk(lanes_.busy, chunk);
+        LaneVector open[kBoardWords + 2] = {};
+        LaneVector unknown[kBoardWords];
+        LaneVector damaged[kBoardWords];
+        LaneVector any_damaged = {};
+        for (int w = 0; w < kBoardWords; ++w) {
+            open[w + 1] = *Chunk(lanes_.destroyed[w], chunk) & ~*Chunk(lanes_.sunk[w], chunk);
+            unknown[w] = *Chunk(board_[w], chunk) & ~*Chunk(lanes_.revealed[w], chunk);
+            damaged[w] = *Chunk(lanes_.damaged[w], chunk);
+            any_damaged |= damaged[w];
+        }
+
+        LaneVector near[kBoardWords];
+        LaneVector any_near = {};
+        for (int w = 0; w < kBoardWords; ++w) {
+            const LaneVector cells = open[w + 1];
+            const LaneVector neighbours = (cells << 1) | (cells >> 1) |
+                                          (cells << Bitboard::kStride) | (open[w] >> (64 - Bitboard::kStride)) |
+                                          (cells >> Bitboard::kStride) | (open[w + 2] << (64 - Bitboard::kStride));
+            near[w] = neighbours & unknown[w];
+            any_near |= near[w];
+        }
+
+        // Правило выбирается по дорожке: маска из всех единиц там, где у правила есть клетки.
+        const LaneVector use_damaged = reinterpret_cast<LaneVector>(any_damaged != 0);
+        const LaneVector use_near = reinterpret_cast<LaneVector>(any_near != 0) & ~use_damaged;
+        const LaneVector use_unknown = ~(use_damaged | use_near);
+        LaneVector candidates[kBoardWords];
+        LaneVector counts[kBoardWords];
+        LaneVector total = {};
+        for (int w = 0; w < kBoardWords; ++w) {
+            candidates[w] = (damaged[w] & use_damaged) | (near[w] & use_near) | (unknown[w] & use_unknown);
+            counts[w] = candidates[w];
+            Popcount(counts[w]);
+            total += counts[w];
+        }
+        stuck |= busy & reinterpret_cast<LaneVector>(total == 0);
+
+        LaneVector random;
+        NextRandom(lanes_.rng, chunk, random);
+        const LaneVector product = (random >> 32) * total;
+        LaneVector n = product >> 32;
+        // Младшая половина произведения меньше числа кандидатов с вероятностью не больше 2^-24:
+        // тогда, как в UniformBelow, число может понадобиться перевыбрать.
+        const LaneVector maybe_biased = busy & reinterpret_cast<LaneVector>((product & 0xFFFFFFFFu) < total);
+        if (AnyLane(maybe_biased)) {
+            for (int i = 0; i < kChunkLanes; ++i) {
+                if (!maybe_biased[i]) continue;
+                const std::uint32_t range = static_cast<std::uint32_t>(total[i]);
+                const std::uint32_t threshold = (0u - range) % range;
+                std::uint64_t value = product[i];
+                while (static_cast<std::uint32_t>(value) < threshold) {
+                    value = (NextLaneRandom(chunk * kChunkLanes + i) >> 32) * range;
+                }
+                n[i] = value >> 32;
+            }
+        }
+
+        // Слово доски, где лежит n-й кандидат, и его номер среди кандидатов этого слова.
+        LaneVector word = {};
+        LaneVector word_index = {};
+        LaneVector rest = n;
+        LaneVector found = {};
+        LaneVector nth = {};
+        for (int w = 0; w < kBoardWords; ++w) {
+            const LaneVector here = reinterpret_cast<LaneVector>(rest < counts[w]) & ~found;
+            word |= candidates[w] & here;
+            nth |= rest & here;
+            word_index |= here & static_cast<std::uint64_t>(w);
+            found |= here;
+            rest -= counts[w];
+        }
+        LaneVector bit;
+        SelectBit(word, nth, bit);
+        const LaneVector one = LaneVector{} + 1;
+        const LaneVector target = one << bit;
+
+        // Выстрел: первое попадание подбивает сегмент, второе уничтожает.
+        LaneVector any_second = {};
+        for (int w = 0; w < kBoardWords; ++w) {
+            const LaneVector shot = target & busy & reinterpret_cast<LaneVector>(word_index == static_cast<std::uint64_t>(w));
+            const LaneVector hit = shot & *Chunk(lanes_.ships[w], chunk);
+            const LaneVector second = hit & damaged[w];
+            *Chunk(lanes_.damaged[w], chunk) = (damaged[w] | hit) & ~second;
+            *Chunk(lanes_.destroyed[w], chunk) |= second;
+            *Chunk(lanes_.revealed[w], chunk) |= shot;
+            any_second |= second;
+        }
+        *Chunk(lanes_.shots, chunk) += busy & one;
+        *Chunk(lanes_.target, chunk) = (word_index << 6) | bit;
+        *Chunk(lanes_.destroyed_segment, chunk) = reinterpret_cast<LaneVector>(any_second != 0);
+    }
+    if (AnyLane(stuck)) {
+        throw std::runtime_error("Флот на дорожке не потоплен, но стрелять некуда");
+    }
+}
+
+
+#ifdef BATTLESHIP_X86_LOCKSTEP_KERNELS
+
+__attribute__((target("avx2")))
+void LockstepSimulator::StepAvx2() {
+    switch (words_) {
+        case 1: StepBody<1>(); break;
+        case 2: StepBody<2>(); break;
+        case 3: StepBody<3>(); break;
+        default: StepBody<4>(); break;
+    }
+}
+
+#endif
+
+
+std::uint64_t LockstepSimulator::NextLaneRandom(int lane) {
+    std::uint64_t& s0 = lanes_.rng[0][lane];
+    std::uint64_t& s1 = lanes_.rng[1][lane];
+    std::uint64_t& s2 = lanes_.rng[2][lane];
+    std::uint64_t& s3 = lanes_.rng[3][lane];
+    const std::uint64_t times5 = s1 * 5;
+    const std::uint64_t result = ((times5 << 7) | (times5 >> 57)) * 9;
+    const std::uint64_t t = s1 << 17;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = (s3 << 45) | (s3 >> 19);
+    return result;
+}
+
+
+void LockstepSimulator::Sink(int lane, int ship) {
+    const Placement& placement = *games_[lane].ships[ship].placement;
+    for (int w = 0; w < words_; ++w) {
+        lanes_.revealed[w][lane] |= placement.halo.word(w);
+        lanes_.sunk[w][lane] |= placement.ship.word(w);
+    }
+    if (--games_[lane].ships_left == 0) {
+        finished_ = true;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef BATTLESHIP_CORE_LOCKSTEPSIMULATOR_H_
+#define BATTLESHIP_CORE_LOCKSTEPSIMULATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "FleetPlacer.h"
+#include "PlacementIndex.h"
+#include "Random.h"
+#include "SimdKernel.h"
+
+// Много партий одного стрелка сразу, по партии на дорожку: для статистики по большим пакетам.
+//
+// Доски kLanes партий лежат по словам: слово w всех дорожек идёт подряд, поэтому весь ход —
+// кандидаты, случайный выбор клетки среди них и сам выстрел — это векторные операции AVX2 сразу
+// над четырьмя дорожками (для 10x10 слов доски три). Стрелок тот же, что HuntTargeting:
+// сначала сегменты, подбитые один раз, затем неизвестные клетки по соседству с попаданиями
+// в непотопленный корабль, иначе любая неизвестная клетка; выбор среди кандидатов
+// равновероятный. Выстрел наносит один урон, как у ИИ, потопленный корабль открывает воду
+// вокруг себя. Способностей и второй стороны нет. Скалярно, по дорожке, делается только учёт
+// уничтоженных сегментов: он нужен не на каждом ходу. Когда флот на дорожке потоплен, на неё
+// ставится следующая расстановка, так что дорожки не простаивают, пока расстановки не кончатся.
+// У каждой дорожки свой генератор xoshiro256**, зёрна для них Run берёт из переданного rng.
+//
+// Без AVX2 партии играются по одной тем же стрелком на битовых досках: версия для базового
+// набора команд по дорожкам оказалась не быстрее её (0.93-1.26x). По lockstep_bench дорожки AVX2
+// быстрее партий по одной на битовых досках в 1.7-2.4 раза на 10x10 и 14x14 и примерно в 1.7 раза
+// на 7x7; разброс между запусками большой. Цель в 10 раз не достигнута: ход стрелка на битовых
+// досках и так стоит десятки наносекунд, и векторам остаётся немного. Прежние 20-40 раз были
+// сравнением с партией через PlayingField и AIObservation, а не с тем же стрелком.
+class LockstepSimulator {
+public:
+    static constexpr int kLanes = 16;
+
+    // AVX2 — дорожки, если процессор её поддерживает; любая другая версия — партии по одной.
+    // Средние числа выстрелов у них совпадают, но сами партии разные: случайные числа
+    // расходуются в другом порядке.
+    LockstepSimulator(int x_size, int y_size, SimdKernel kernel = BestSimdKernel());
+
+    // Сыграть по партии на каждой расстановке; shots[i] — выстрелов до потопления флота layouts[i].
+    // При том же состоянии rng и той же версии результат повторяется. Бросает std::invalid_argument,
+    // если корабль расстановки не помещается на поле или корабли пересекаются либо касаются.
+    void Run(const std::vector<std::vector<ShipPlacement>>& layouts, Rng& rng, std::vector<int>& shots);
+
+    // AVX2 или SCALAR.
+    SimdKernel kernel() const;
+
+private:
+    using LaneWords = std::array<std::uint64_t, kLanes>;
+    using Planes = std::array<LaneWords, Bitboard::kWords>;
+
+    // Состояние всех дорожек, по слову на дорожку. Векторный ход работает только с ним.
+    struct alignas(64) Lanes {
+        Planes ships;
+        // Сегменты, подбитые один раз, и уничтоженные сегменты.
+        Planes damaged;
+        Planes destroyed;
+        // Клетки, про которые стрелок знает: обстрелянные и вода вокруг потопленных кораблей.
+        Planes revealed;
+        Planes sunk;
+        // Состояние генератора каждой дорожки.
+        std::array<LaneWords, 4> rng;
+        // Все единицы у дорожки, на которой идёт партия, иначе ноль.
+        LaneWords busy;
+        LaneWords shots;
+        // Бит последнего выстрела и все единицы, если выстрел уничтожил сегмент.
+        LaneWords target;
+        LaneWords destroyed_segment;
+    };
+
+    // Корабль на дорожке: его позиция и сколько сегментов ещё не уничтожено.
+    struct LaneShip {
+        const Placement* placement;
+        int segments_left;
+    };
+
+    struct LaneGame {
+        int layout = -1;
+        int ships_left = 0;
+        std::vector<LaneShip> ships;
+        // Номер корабля в ships для каждой клетки доски или -1.
+        std::array<std::int8_t, Bitboard::kWords * 64> ship_at;
+    };
+
+    // Партия по одной на битовых досках, когда AVX2 нет.
+    int PlayOne(const std::vector<ShipPlacement>& placements, Rng& rng) const;
+    void Load(int lane, int layout, const std::vector<ShipPlacement>& placements);
+    void Clear(int lane);
+    // Один выстрел на каждой занятой дорожке. StepBody собирается под AVX2 отдельно для каждого
+    // числа слов доски.
+    void Step();
+    template <int kBoardWords>
+    void StepBody();
+    void StepAvx2();
+    // Следующее число генератора дорожки: для редкого точного дополнения выбора по Лемиру.
+    std::uint64_t NextLaneRandom(int lane);
+    void Sink(int lane, int ship);
+
+    int x_size_;
+    int y_size_;
+    // Сколько слов доски занимает поле.
+    int words_;
+    SimdKernel kernel_;
+    Planes board_;
+    Lanes lanes_;
+    std::array<LaneGame, kLanes> games_;
+    // На последнем ходу какая-то дорожка потопила весь флот.
+    bool finished_ = false;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "PlacementIndex.h"
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+
+
+namespace {
+
+constexpr int kStandardMinSide = 10;
+constexpr int kStandardMaxSide = 14;
+
+constexpr int PlacementCount(int x_size, int y_size, int ship_size) {
+    if (ship_size > x_size && ship_size > y_size) return 0;
+    const int horizontal = (ship_size <= x_size) ? (x_size - ship_size + 1) * y_size : 0;
+    const int vertical = (ship_size > 1 && ship_size <= y_size) ? (y_size - ship_size + 1) * x_size : 0;
+    return horizontal + vertical;
+}
+
+// Заполняет позиции и таблицу по началу; одна и та же функция работает и при компиляции, и в рантайме.
+constexpr void FillPlacements(int x_size, int y_size, int ship_size, Placement* placements,
+                              std::int16_t* by_origin) {
+    for (int i = 0; i < PlacementIndex::kOriginSlots; ++i) by_origin[i] = -1;
+
+    const Bitboard board = BoardMask(x_size, y_size);
+    int count = 0;
+    for (Orientation orientation : {Orientation::HORIZONTAL, Orientation::VERTICAL}) {
+        if (ship_size == 1 && orientation == Orientation::VERTICAL) continue;
+        const int w = (orientation == Orientation::HORIZONTAL) ? ship_size : 1;
+        const int h = (orientation == Orientation::VERTICAL) ? ship_size : 1;
+        for (int y = 0; y + h <= y_size; ++y) {
+            for (int x = 0; x + w <= x_size; ++x) {
+                Placement& p = placements[count];
+                p.x = x;
+                p.y = y;
+                p.orientation = orientation;
+                p.ship = ShipMask(x, y, ship_size, orientation);
+                p.halo = HaloMask(x, y, ship_size, orientation) & board;
+                by_origin[static_cast<int>(orientation) * Bitboard::kWords * 64 + Bitboard::BitIndex(x, y)] =
+                    static_cast<std::int16_t>(count);
+                ++count;
+            }
+        }
+    }
+
+    // У однопалубного корабля вертикальная позиция совпадает с горизонтальной.
+    if (ship_size == 1) {
+        for (int bit = 0; bit < Bitboard::kWords * 64; ++bit) {
+            by_origin[static_cast<int>(Orientation::VERTICAL) * Bitboard::kWords * 64 + bit] =
+                by_origin[static_cast<int>(Orientation::HORIZONTAL) * Bitboard::kWords * 64 + bit];
+        }
+    }
+}
+
+
+template <int Side, int ShipSize>
+struct StaticTable {
+    static constexpr int kCount = PlacementCount(Side, Side, ShipSize);
+    std::array<Placement, kCount> placements{};
+    std::array<std::int16_t, PlacementIndex::kOriginSlots> by_origin{};
+};
+
+template <int Side, int ShipSize>
+constexpr StaticTable<Side, ShipSize> MakeStaticTable() {
+    StaticTable<Side, ShipSize> table{};
+    FillPlacements(Side, Side, ShipSize, table.placements.data(), table.by_origin.data());
+    return table;
+}
+
+template <int Side, int ShipSize>
+constexpr StaticTable<Side, ShipSize> kStaticTable = MakeStaticTable<Side, ShipSize>();
+
+template <int Side, int ShipSize>
+constexpr PlacementIndex StaticIndex() {
+    return PlacementIndex(Side, Side, ShipSize, kStaticTable<Side, ShipSize>.placements.data(),
+                          StaticTable<Side, ShipSize>::kCount, kStaticTable<Side, ShipSize>.by_origin.data());
+}
+
+template <int Side>
+constexpr std::array<PlacementIndex, Ship::kMaxSize> StaticIndexesForSide() {
+    return {StaticIndex<Side, 1>(), StaticIndex<Side, 2>(), StaticIndex<Side, 3>(), StaticIndex<Side, 4>()};
+}
+
+constexpr std::array<std::array<PlacementIndex, Ship::kMaxSize>, kStandardMaxSide - kStandardMinSide + 1>
+    kStandardIndexes = {StaticIndexesForSide<10>(), StaticIndexesForSide<11>(), StaticIndexesForSide<12>(),
+                        StaticIndexesForSide<13>(), StaticIndexesForSide<14>()};
+
+
+// Индекс для нестандартного поля вместе с данными, на которые он ссылается.
+struct DynamicTable {
+    std::vector<Placement> placements;
+    std::array<std::int16_t, PlacementIndex::kOriginSlots> by_origin{};
+    PlacementIndex index;
+
+    DynamicTable(int x_size, int y_size, int ship_size)
+        : placements(PlacementCount(x_size, y_size, ship_size)),
+          index(x_size, y_size, ship_size, nullptr, 0, nullptr) {
+        FillPlacements(x_size, y_size, ship_size, placements.data(), by_origin.data());
+        index = PlacementIndex(x_size, y_size, ship_size, placements.data(),
+                               static_cast<int>(placements.size()), by_origin.data());
+    }
+};
+
+}
+
+
+const PlacementIndex& PlacementIndex::Get(int x_size, int y_size, int ship_size) {
+    if (x_size == y_size && x_size >= kStandardMinSide && x_size <= kStandardMaxSide) {
+        return kStandardIndexes[x_size - kStandardMinSide][ship_size - 1];
+    }
+
+    static std::mutex mutex;
+    static std::map<std::tuple<int, int, int>, std::unique_ptr<DynamicTable>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& table = tables[std::make_tuple(x_size, y_size, ship_size)];
+    if (!table) {
+        table = std::make_unique<DynamicTable>(x_size, y_size, ship_size);
+    }
+    return table->index;
+}
+
+
+const Placement* PlacementIndex::Find(int x, int y, Orientation orientation) const noexcept {
+    if (x < 0 || y < 0 || x >= x_size_ || y >= y_size_) {
+        return nullptr;
+    }
+    const int slot = by_origin_[static_cast<int>(orientation) * Bitboard::kWords * 64 + Bitboard::BitIndex(x, y)];
+    return (slot < 0) ? nullptr : &placements_[slot];
+}
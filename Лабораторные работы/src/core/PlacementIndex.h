@@ -0,0 +1,61 @@
+#ifndef BATTLESHIP_CORE_PLACEMENTINDEX_H_
+#define BATTLESHIP_CORE_PLACEMENTINDEX_H_
+
+#include <cstdint>
+#include "Bitboard.h"
+#include "Ship.h"
+
+// Одна допустимая позиция корабля: начало, ориентация, клетки корабля и клетки,
+// в которых не может стоять другой корабль (сам корабль и соседи, обрезанные по полю).
+struct Placement {
+    int x = 0;
+    int y = 0;
+    Orientation orientation = Orientation::HORIZONTAL;
+    Bitboard ship;
+    Bitboard halo;
+};
+
+
+// Все позиции корабля заданного размера, целиком лежащие на поле x_size x y_size.
+//
+// Для квадратных полей 10–14 индексы строятся на этапе компиляции, для остальных полей —
+// один раз при первом обращении. Индекс неизменяем и живёт до конца программы, поэтому
+// ссылки на него и на его позиции можно хранить.
+// Однопалубный корабль в обеих ориентациях занимает одну клетку, поэтому его позиции
+// перечислены один раз, а Find возвращает одну и ту же позицию для любой ориентации.
+class PlacementIndex {
+public:
+    // ship_size должен быть от 1 до Ship::kMaxSize, стороны поля — от 1 до Bitboard::kMaxSide.
+    static const PlacementIndex& Get(int x_size, int y_size, int ship_size);
+
+    constexpr PlacementIndex(int x_size, int y_size, int ship_size, const Placement* placements,
+                             int count, const std::int16_t* by_origin)
+        : x_size_(x_size), y_size_(y_size), ship_size_(ship_size),
+          placements_(placements), count_(count), by_origin_(by_origin) {}
+
+    // Позиция с началом в (x, y) или nullptr, если корабль так не помещается на поле.
+    const Placement* Find(int x, int y, Orientation orientation) const noexcept;
+
+    const Placement* begin() const { return placements_; }
+    const Placement* end() const { return placements_ + count_; }
+    const Placement& operator[](int index) const { return placements_[index]; }
+
+    int count() const { return count_; }
+    int x_size() const { return x_size_; }
+    int y_size() const { return y_size_; }
+    int ship_size() const { return ship_size_; }
+
+    // Размер таблицы by_origin: номер позиции для каждой ориентации и каждого бита доски.
+    static constexpr int kOriginSlots = 2 * Bitboard::kWords * 64;
+
+private:
+    int x_size_;
+    int y_size_;
+    int ship_size_;
+    const Placement* placements_;
+    int count_;
+    // by_origin[orientation * 256 + BitIndex(x, y)] — номер позиции или -1.
+    const std::int16_t* by_origin_;
+};
+
+#endif
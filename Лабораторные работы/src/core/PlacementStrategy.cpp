@@ -0,0 +1,31 @@
+#include "PlacementStrategy.h"
+#include "LayoutPool.h"
+#include "LayoutSampler.h"
+
+
+
+UniformPlacement::UniformPlacement(bool use_pool, std::size_t node_budget)
+        : use_pool_(use_pool), node_budget_(node_budget) {}
+
+
+const char* UniformPlacement::name() const {
+    return "uniform";
+}
+
+
+bool UniformPlacement::Place(int x_size, int y_size, const std::vector<int>& sizes, Rng& rng,
+                             std::vector<ShipPlacement>& layout, const Bitboard& occupied) const {
+    const std::uint64_t seed = LayoutPool::NextSeed(rng);
+
+    // Для пустого поля расстановка из этого зерна обычно уже построена в фоновом запасе.
+    if (use_pool_ && !occupied.Any()) {
+        LayoutPool& pool = LayoutPool::getInstance();
+        const bool from_pool = pool.Take(x_size, y_size, sizes, seed, layout, node_budget_);
+        pool.Prefetch(x_size, y_size, sizes, rng, node_budget_);
+        if (from_pool) {
+            return true;
+        }
+    }
+    Rng gen(seed);
+    return GenerateFleetLayout(x_size, y_size, sizes, gen, layout, occupied, node_budget_);
+}
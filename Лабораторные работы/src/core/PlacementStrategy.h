@@ -0,0 +1,43 @@
+#ifndef BATTLESHIP_CORE_PLACEMENTSTRATEGY_H_
+#define BATTLESHIP_CORE_PLACEMENTSTRATEGY_H_
+
+#include <cstddef>
+#include <vector>
+#include "Bitboard.h"
+#include "FleetPlacer.h"
+#include "Random.h"
+
+// Как игрок расставляет свой флот.
+class PlacementStrategy {
+public:
+    virtual ~PlacementStrategy() = default;
+
+    virtual const char* name() const = 0;
+
+    // Расставляет корабли sizes на поле x_size x y_size вокруг уже стоящих кораблей occupied.
+    // В layout возвращается позиция для каждого корабля в порядке sizes.
+    // Возвращает false, если расставить флот не удалось.
+    virtual bool Place(int x_size, int y_size, const std::vector<int>& sizes, Rng& rng,
+                       std::vector<ShipPlacement>& layout, const Bitboard& occupied = Bitboard()) const = 0;
+};
+
+
+// Равномерно случайная расстановка (GenerateFleetLayout). Берёт из rng ровно одно число —
+// зерно расстановки, поэтому при том же зерне расстановка повторяется.
+// С use_pool расстановка для пустого поля берётся из фонового запаса LayoutPool, если она
+// там уже построена, и запас пополняется; в запасе лежит та же расстановка, что получилась
+// бы на месте. Запас рассчитан на одну партию: при многих партиях сразу его лучше выключить.
+class UniformPlacement : public PlacementStrategy {
+public:
+    explicit UniformPlacement(bool use_pool = true, std::size_t node_budget = FleetPlacer::kDefaultNodeBudget);
+
+    const char* name() const override;
+    bool Place(int x_size, int y_size, const std::vector<int>& sizes, Rng& rng,
+               std::vector<ShipPlacement>& layout, const Bitboard& occupied = Bitboard()) const override;
+
+private:
+    bool use_pool_;
+    std::size_t node_budget_;
+};
+
+#endif
@@ -67,11 +67,11 @@ Orientation Player::current_orientation(){
     return field_->current_orientation();
 }
 
-bool Player::PlaceShipsRandomly() {
+bool Player::PlaceShipsRandomly(Rng& rng, const PlacementStrategy& strategy) {
     if (!ship_manager_) {
         return false;
     }
-    return field_->SetRandomShips(*ship_manager_);
+    return field_->SetRandomShips(*ship_manager_, rng, strategy);
 }
 
 std::string Player::name() const { 
@@ -29,7 +29,7 @@ public:
     
     void RotateCurrentShip();
     Orientation current_orientation();
-    bool PlaceShipsRandomly();
+    bool PlaceShipsRandomly(Rng& rng, const PlacementStrategy& strategy);
 
     std::string name() const;
     PlayerType type() const;
@@ -3,28 +3,47 @@
 #include "additional/Other.h"
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 
 
 
+namespace {
+
+const Cell kEmptyCell(CellState::EMPTY);
+
+// Версия 1 (без строки версии) хранила видимое поле тройками, как реальное;
+// начиная с версии 2 вместо него пишется маска открытых клеток.
+const int kSaveFormatVersion = 2;
+
+void CheckFieldSize(int x, int y) {
+    if (x < 1 || y < 1 || x > Bitboard::kMaxSide || y > Bitboard::kMaxSide) {
+        throw std::invalid_argument("Размер поля должен быть от 1 до " + std::to_string(Bitboard::kMaxSide));
+    }
+}
+
+}
+
+
 PlayingField::PlayingField(int x, int y) : x_size_(x), y_size_(y), count_(0) {
-    real_grid_.resize(y_size_, std::vector<Cell>(x_size_, Cell(CellState::EMPTY)));
-    visible_grid_.resize(y_size_, std::vector<Cell>(x_size_, Cell(CellState::UNKNOWN)));
-    scanned_overlay_.resize(y_size_, std::vector<bool>(x_size_, false));
+    CheckFieldSize(x_size_, y_size_);
+    storage_ = std::make_shared<Storage>();
+    storage_->grid.assign(static_cast<size_t>(x_size_) * y_size_, kEmptyCell);
     is_in_replacement_mode_ = false;
 }
 
 
+// Копия разделяет с оригиналом сетку и корабли; своё хранилище появляется
+// только при первом изменении (см. MutableStorage).
 PlayingField::PlayingField(const PlayingField& other)
-        : x_size_(other.x_size_)
+        : storage_(other.storage_)
+        , occupied_(other.occupied_)
+        , revealed_(other.revealed_)
+        , scanned_(other.scanned_)
+        , x_size_(other.x_size_)
         , y_size_(other.y_size_)
         , count_(other.count_)
         , is_in_replacement_mode_(other.is_in_replacement_mode_)
 {
-    real_grid_ = other.real_grid_;
-    visible_grid_ = other.visible_grid_;
-    scanned_overlay_ = other.scanned_overlay_;
-    ships_ = other.ships_;          
-    removed_ships_ = other.removed_ships_; 
 }
 
 PlayingField& PlayingField::operator=(const PlayingField& other) {
@@ -35,51 +54,41 @@ PlayingField& PlayingField::operator=(const PlayingField& other) {
     count_ = other.count_;
     is_in_replacement_mode_ = other.is_in_replacement_mode_;
 
-    real_grid_ = other.real_grid_;
-    visible_grid_ = other.visible_grid_;
-    scanned_overlay_ = other.scanned_overlay_;
-    ships_ = other.ships_;
-    removed_ships_ = other.removed_ships_;
+    storage_ = other.storage_;
+    occupied_ = other.occupied_;
+    revealed_ = other.revealed_;
+    scanned_ = other.scanned_;
 
     return *this;
 }
 
+// Перемещённое поле остаётся рабочей копией: хранилище разделяется, а не забирается, поэтому
+// перемещение стоит одного счётчика ссылок и у исходного объекта не остаётся пустого хранилища.
 PlayingField::PlayingField(PlayingField&& other) noexcept
-        : real_grid_(std::move(other.real_grid_))
-        , visible_grid_(std::move(other.visible_grid_))
-        , scanned_overlay_(std::move(other.scanned_overlay_))
-        , ships_(std::move(other.ships_))
-        , removed_ships_(std::move(other.removed_ships_))
+        : storage_(other.storage_)
+        , occupied_(other.occupied_)
+        , revealed_(other.revealed_)
+        , scanned_(other.scanned_)
         , x_size_(other.x_size_)
         , y_size_(other.y_size_)
         , count_(other.count_)
         , is_in_replacement_mode_(other.is_in_replacement_mode_)
 {
-    other.x_size_ = 0;
-    other.y_size_ = 0;
-    other.count_ = 0;
-    other.is_in_replacement_mode_ = false;
 }
 
 PlayingField& PlayingField::operator=(PlayingField&& other) noexcept {
     if (this == &other) return *this;
 
-    real_grid_ = std::move(other.real_grid_);
-    visible_grid_ = std::move(other.visible_grid_);
-    scanned_overlay_ = std::move(other.scanned_overlay_);
-    ships_ = std::move(other.ships_);
-    removed_ships_ = std::move(other.removed_ships_);
+    storage_ = other.storage_;
+    occupied_ = other.occupied_;
+    revealed_ = other.revealed_;
+    scanned_ = other.scanned_;
 
     x_size_ = other.x_size_;
     y_size_ = other.y_size_;
     count_ = other.count_;
     is_in_replacement_mode_ = other.is_in_replacement_mode_;
 
-    other.x_size_ = 0;
-    other.y_size_ = 0;
-    other.count_ = 0;
-    other.is_in_replacement_mode_ = false;
-    
     return *this;
 }
 
@@ -95,7 +104,35 @@ std::istream& operator>>(std::istream& is, PlayingField& field) {
 }
 
 
+PlacementStatus PlayingField::CanPlace(int x, int y, int size, Orientation orientation) const noexcept {
+    if (size < 1 || size > bitboard_detail::kMaxShipSize) {
+        return PlacementStatus::INVALID_SIZE;
+    }
+    const Placement* placement = PlacementIndex::Get(x_size_, y_size_, size).Find(x, y, orientation);
+    if (placement == nullptr) {
+        return PlacementStatus::OUT_OF_BOUNDS;
+    }
+    if (occupied_.Intersects(placement->ship)) {
+        return PlacementStatus::OVERLAP;
+    }
+    if (occupied_.Intersects(placement->halo)) {
+        return PlacementStatus::TOO_CLOSE;
+    }
+    return PlacementStatus::OK;
+}
+
+
 void PlayingField::MoveShip(int x, int y, int size, Orientation orientation){
+    const PlacementStatus status = CanPlace(x, y, size, orientation);
+    if (status == PlacementStatus::OK) {
+        return;
+    }
+    if (status == PlacementStatus::INVALID_SIZE) {
+        throw InvalidShipSizeException(size);
+    }
+
+    // Медленный проход нужен только для того, чтобы указать в исключении конкретную клетку.
+    // Причины проверяются в том же порядке, что и в CanPlace.
     std::vector<std::pair<int, int>> ship_cells;
     for (int i = 0; i < size; ++i) {
         int curr_x = (orientation == Orientation::HORIZONTAL) ? x + i : x;
@@ -105,11 +142,13 @@ void PlayingField::MoveShip(int x, int y, int size, Orientation orientation){
             throw ShipOutOfBoundsException(curr_x, curr_y, x_size_, y_size_);
         }
 
-        if (real_grid_[curr_y][curr_x].IsShip()) {
+        ship_cells.emplace_back(curr_x, curr_y);
+    }
+
+    for (auto [curr_x, curr_y] : ship_cells) {
+        if (occupied_.Test(curr_x, curr_y)) {
             throw ShipsOverlapException(curr_x, curr_y);
         }
-
-        ship_cells.emplace_back(curr_x, curr_y);
     }
 
     for (auto [curr_x, curr_y] : ship_cells) {
@@ -118,7 +157,7 @@ void PlayingField::MoveShip(int x, int y, int size, Orientation orientation){
                 int adj_x = curr_x + dx;
                 int adj_y = curr_y + dy;
 
-                if (IsValid(adj_x, adj_y, x_size_, y_size_) && real_grid_[adj_y][adj_x].IsShip()) {
+                if (IsValid(adj_x, adj_y, x_size_, y_size_) && occupied_.Test(adj_x, adj_y)) {
                     throw ShipsTooCloseException(curr_x, curr_y, adj_x, adj_y);
                 }
             }
@@ -126,36 +165,20 @@ void PlayingField::MoveShip(int x, int y, int size, Orientation orientation){
     }
 }
 
-bool PlayingField::SetRandomShips(const ShipManager& manager, size_t max_attempts) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
+bool PlayingField::SetRandomShips(const ShipManager& manager, Rng& rng, const PlacementStrategy& strategy) {
+    std::vector<int> sizes(manager.ship_count());
     for (int i = 0; i < manager.ship_count(); i++) {
-        int ship_size = manager.ship_size(i);
-        bool placed = false;
-        size_t attempts = 0;
-
-        while (!placed && attempts < max_attempts) {
-            attempts++;
-            std::uniform_int_distribution<> distX(0, x_size_ - 1);
-            std::uniform_int_distribution<> distY(0, y_size_ - 1);
-            std::uniform_int_distribution<> distOrientation(0, 1);
-
-            int x = distX(gen);
-            int y = distY(gen);
-            Orientation orient = (distOrientation(gen) == 0) ? Orientation::HORIZONTAL : Orientation::VERTICAL;
-
-            try {
-                PlaceShip(x, y, ship_size, orient);
-                placed = true;
-            } catch (const std::exception&) { }
-        }
+        sizes[i] = manager.ship_size(i);
+    }
 
-        if (!placed) {
-            return false;
-        }
+    std::vector<ShipPlacement> layout;
+    if (!strategy.Place(x_size_, y_size_, sizes, rng, layout, occupied_)) {
+        return false;
     }
 
+    for (const ShipPlacement& p : layout) {
+        PlaceShip(p.x, p.y, p.size, p.orientation);
+    }
     return true;
 }
 
@@ -172,35 +195,40 @@ Orientation PlayingField::current_orientation() const {
 
 
 bool PlayingField::PlaceRemovedShip(int x, int y, int size, Orientation orientation) {
-    if (removed_ships_.empty()) return false;
-        
-    Ship ship_to_place = removed_ships_.back();
-        
+    if (storage_->free_slots.empty()) return false;
+
+    const int slot = storage_->free_slots.back();
     MoveShip(x,y,size,orientation);
+
+    // Корабль возвращается в свой же слот, поэтому его номер и номера остальных не меняются.
+    Storage& data = MutableStorage();
+    Ship& ship_to_place = data.ships[slot].ship;
     ship_to_place.set_start_position(Position(x, y));
     ship_to_place.set_orientation(orientation);
-    ship_to_place.set_ship_number(count_);
+    data.free_slots.pop_back();
     PlaceShipOnGrid(ship_to_place);
-    removed_ships_.pop_back();
-        
-    if (removed_ships_.empty()) {
+
+    if (data.free_slots.empty()) {
         is_in_replacement_mode_ = false;
     }
-        
+
     return true;
 }
 
 
 bool PlayingField::PlaceNewShip(int x, int y, int size, Orientation orientation){
     MoveShip(x,y,size,orientation);
-    Ship ship(Position(x, y), orientation, size, count_);
-    PlaceShipOnGrid(ship);
+    Storage& data = MutableStorage();
+    const int slot = static_cast<int>(data.ships.size());
+    data.ships.push_back(ShipSlot{Ship(Position(x, y), orientation, size, slot), 0, false});
+    PlaceShipOnGrid(data.ships.back().ship);
 
     return true;
 }
 
 
 void PlayingField::PlaceShipOnGrid(const Ship& ship_to_place){
+    Storage& data = MutableStorage();
     int x = ship_to_place.start_position().x; 
     int y = ship_to_place.start_position().y;
     int ship_number = ship_to_place.ship_number();
@@ -208,15 +236,17 @@ void PlayingField::PlaceShipOnGrid(const Ship& ship_to_place){
     for (int i = 0; i < ship_to_place.ship_size(); ++i) {
         int curr_x = (ship_to_place.orientation() == Orientation::HORIZONTAL) ? x + i : x;
         int curr_y = (ship_to_place.orientation() == Orientation::VERTICAL) ? y + i : y;
-        real_grid_[curr_y][curr_x].set_ship(i, ship_number);
+        mutable_grid_cell(curr_x, curr_y).set_ship(i, ship_number);
+        occupied_.Set(curr_x, curr_y);
     }
-    ships_.push_back(ship_to_place);
+    data.ships[ship_number].placed = true;
+    data.fleet.AddShip(ship_to_place, ship_number);
     ++count_;
 }
 
 
 bool PlayingField::PlaceShip(int x, int y, int size, Orientation orientation) {
-    if (is_in_replacement_mode_ && !removed_ships_.empty()) {
+    if (is_in_replacement_mode_ && !storage_->free_slots.empty()) {
         return PlaceRemovedShip(x, y, size, orientation);
     } else {
         return PlaceNewShip(x, y, size, orientation);
@@ -229,51 +259,43 @@ int PlayingField::Damage(int x, int y, int damage) {
         throw ShipOutOfBoundsException(x, y, x_size_, y_size_);
     }
 
-    if (!real_grid_[y][x].IsShip()) {
-        if (!visible_grid_[y][x].IsUnknown()) {
+    const Cell& target = grid_cell(x, y);
+    if (!target.IsShip()) {
+        if (revealed_.Test(x, y)) {
             return -1;
         }
-        visible_grid_[y][x].set_empty();
+        revealed_.Set(x, y);
         return 0;
     }
 
-    const int ship_index = real_grid_[y][x].ship_index();
-    const int index = real_grid_[y][x].segment_index();
+    const int ship_index = target.ship_index();
+    const int index = target.segment_index();
 
-    if (ship_index < 0 || index < 0 || 
-        static_cast<size_t>(ship_index) >= ships_.size()) {
+    if (ship_index < 0 || index < 0 || !IsShipPlaced(ship_index)) {
         return -1;
     }
 
-    SegmentState before = ships_[ship_index].segment_state(index);
-    if (before == SegmentState::DESTROYED) {
+    if (storage_->ships[ship_index].ship.segment_state(index) == SegmentState::DESTROYED) {
         return -1; 
     }
 
-    ships_[ship_index].DamageShip(Position(x, y), damage);
+    // Хранилище копируется только тогда, когда выстрел действительно меняет корабль.
+    Storage& data = MutableStorage();
+    Ship& ship = data.ships[ship_index].ship;
 
-    visible_grid_[y][x].set_ship(index, ship_index);
+    const int alive_before = ship.alive_segments();
+    ship.DamageShip(Position(x, y), damage);
+    data.fleet.OnSegmentsLost(alive_before - ship.alive_segments());
 
-    if (ships_[ship_index].IsDestroyed()) {
-        int sz = ships_[ship_index].ship_size();
-        for (int i = 0; i < sz; ++i) {
-            Position p = ships_[ship_index].segment_position(i);
-            if (IsValid(p.x, p.y, x_size_, y_size_)) {
-                visible_grid_[p.y][p.x].set_ship(i, ship_index);
-            }
-        }
-        auto mark_water = [&](int px, int py){
-            if (IsValid(px, py, x_size_, y_size_) && visible_grid_[py][px].IsUnknown()) {
-                visible_grid_[py][px].set_empty();
-            }
-        };
-        for (int i = 0; i < sz; ++i) {
-            Position p = ships_[ship_index].segment_position(i);
-            for (int dy = -1; dy <= 1; ++dy)
-                for (int dx = -1; dx <= 1; ++dx)
-                    mark_water(p.x + dx, p.y + dy);
-        }
-        ships_[ship_index].MarkFullyDestroyed();
+    revealed_.Set(x, y);
+
+    if (ship.IsDestroyed()) {
+        // Потопленный корабль открывается целиком вместе с водой вокруг него.
+        const Position start = ship.start_position();
+        revealed_ |= PlacementIndex::Get(x_size_, y_size_, ship.ship_size())
+                         .Find(start.x, start.y, ship.orientation())->halo;
+        data.fleet.OnShipDestroyed(ship);
+        ship.MarkFullyDestroyed();
         return 2; 
     }
 
@@ -282,60 +304,46 @@ int PlayingField::Damage(int x, int y, int damage) {
 
 
 bool PlayingField::IsShipCell(int x, int y) const {
-    return real_grid_[y][x].IsShip();
+    return occupied_.Test(x, y);
 }
 
 
 bool PlayingField::IsScanned(int x, int y) const {
     if (!IsValid(x, y, x_size_, y_size_)) return false;
-    return scanned_overlay_[y][x];
+    return scanned_.Test(x, y);
 }
 
 
 bool PlayingField::IsAllShipsDestroyed() const {
-    for (const auto& ship : ships_) {
-        if (!ship.IsDestroyed()) {
-            return false;
-        }
-    }
-    return true;
+    return storage_->fleet.alive_ships() == 0;
 }
 
 
 bool PlayingField::HasShipsToReplace() const {
-    return !removed_ships_.empty();
+    return !storage_->free_slots.empty();
 }
 
 
 void PlayingField::ClearField() {
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            real_grid_[y][x].set_empty();
-        }
-    }
-
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            visible_grid_[y][x].set_unknown(); 
-        }
-    }
-
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            scanned_overlay_[y][x] = false;
-        }
-    }
+    storage_ = std::make_shared<Storage>();
+    storage_->grid.assign(static_cast<size_t>(x_size_) * y_size_, kEmptyCell);
+    occupied_.Clear();
+    revealed_.Clear();
+    scanned_.Clear();
     
-    ships_.clear();
     count_ = 0; 
+    is_in_replacement_mode_ = false;
 }
 
 
 void PlayingField::ClearShip(int x, int y) {
-    int ship_index = real_grid_[y][x].ship_index();
-    if (ship_index < 0) return;
+    if (!occupied_.Test(x, y)) return;
+
+    Storage& data = MutableStorage();
+    int ship_index = grid_cell(x, y).ship_index();
+    if (ship_index < 0 || !IsShipPlaced(ship_index)) return;
 
-    Ship ship_to_remove = ships_[ship_index]; 
+    const Ship& ship_to_remove = data.ships[ship_index].ship;
 
     Orientation orientation = ship_to_remove.orientation();
     Position pos = ship_to_remove.start_position();
@@ -348,14 +356,16 @@ void PlayingField::ClearShip(int x, int y) {
     int length = ship_to_remove.ship_size();
     
     for (int j = 0; j < length; j++) {
-        real_grid_[current_y][current_x].reset();
+        mutable_grid_cell(current_x, current_y).reset();
+        occupied_.Reset(current_x, current_y);
         current_x += dx;
         current_y += dy;
     }
 
-    removed_ships_.push_back(ship_to_remove);
-    ships_.erase(ships_.begin() + ship_index);
-    UpdateShipNumbersAfterRemoval(ship_index);
+    data.fleet.RemoveShip(ship_to_remove);
+    data.ships[ship_index].placed = false;
+    ++data.ships[ship_index].generation;
+    data.free_slots.push_back(ship_index);
 
     is_in_replacement_mode_ = true;
     --count_;
@@ -363,75 +373,61 @@ void PlayingField::ClearShip(int x, int y) {
 
 
 void PlayingField::ReturnStartState(){
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            visible_grid_[y][x].set_unknown(); 
-        }
-    }
-
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            scanned_overlay_[y][x] = false;
-        }
-    }
+    Storage& data = MutableStorage();
+    revealed_.Clear();
+    scanned_.Clear();
     
-    for (size_t i = 0; i < ships_.size(); i++){
-        for (int j = 0; j < ships_[i].ship_size(); j++){
-            ships_[i].set_segment_state(j, SegmentState::INTACT);
+    for (ShipSlot& slot : data.ships) {
+        if (!slot.placed) continue;
+        for (int j = 0; j < slot.ship.ship_size(); j++){
+            slot.ship.set_segment_state(j, SegmentState::INTACT);
         }
     } 
+    RebuildFleet();
 }
 
 
-void PlayingField::UpdateShipNumbersAfterRemoval(int removed_index) {
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            if (real_grid_[y][x].IsShip()) {
-                int ship_index = real_grid_[y][x].ship_index();
-                if (ship_index > removed_index) {
-                    real_grid_[y][x].set_ship_index(ship_index - 1);
-                }
-            }
+void PlayingField::RebuildFleet() {
+    Storage& data = MutableStorage();
+    data.fleet.Clear();
+    for (size_t i = 0; i < data.ships.size(); ++i) {
+        if (data.ships[i].placed) {
+            data.fleet.AddShip(data.ships[i].ship, static_cast<int>(i));
         }
     }
-    
-    for (size_t i = removed_index; i < ships_.size(); ++i) {
-        ships_[i].set_ship_number(ships_[i].ship_number() - 1);
-    }
 }
 
 
 void PlayingField::save(std::ostream& out) const {
+    out << 'v' << kSaveFormatVersion << '\n';
     out << x_size_ << ' ' << y_size_ << '\n';
     out << count_ << ' ' << is_in_replacement_mode_ << '\n';
 
     for (int y = 0; y < y_size_; ++y) {
         for (int x = 0; x < x_size_; ++x) {
-            out << static_cast<int>(real_grid_[y][x].segment_state()) << ' ';
-            out << real_grid_[y][x].ship_index() << ' ';
-            out << real_grid_[y][x].segment_index() << ' ';
-        }
-        out << '\n';
-    }
-
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            out << static_cast<int>(visible_grid_[y][x].segment_state()) << ' ';
-            out << visible_grid_[y][x].ship_index() << ' ';
-            out << visible_grid_[y][x].segment_index() << ' ';
+            const Cell& cell = grid_cell(x, y);
+            out << static_cast<int>(cell.segment_state()) << ' ';
+            out << cell.ship_index() << ' ';
+            out << cell.segment_index() << ' ';
         }
         out << '\n';
     }
 
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            out << (scanned_overlay_[y][x] ? '1' : '0') << ' ';
+    auto save_mask = [&](const Bitboard& mask) {
+        for (int y = 0; y < y_size_; ++y) {
+            for (int x = 0; x < x_size_; ++x) {
+                out << (mask.Test(x, y) ? '1' : '0') << ' ';
+            }
+            out << '\n';
         }
-        out << '\n';
-    }
-
-    out << ships_.size() << '\n';
-    for (const auto& s : ships_) {
+    };
+    save_mask(revealed_);
+    save_mask(scanned_);
+
+    out << storage_->ships.size() - storage_->free_slots.size() << '\n';
+    for (const ShipSlot& slot : storage_->ships) {
+        if (!slot.placed) continue;
+        const Ship& s = slot.ship;
         out << s.start_position().x << ' ' << s.start_position().y << ' '
             << s.ship_size() << ' ' << static_cast<int>(s.orientation()) << ' '
             << s.ship_number() << ' ' << s.destroyed_segments() << ' ' << s.hit_count() << '\n';
@@ -442,8 +438,9 @@ void PlayingField::save(std::ostream& out) const {
         out << '\n';
     }
 
-    out << removed_ships_.size() << '\n';
-    for (const auto& s : removed_ships_) {
+    out << storage_->free_slots.size() << '\n';
+    for (int index : storage_->free_slots) {
+        const Ship& s = storage_->ships[index].ship;
         out << s.start_position().x << ' ' << s.start_position().y << ' '
             << s.ship_size() << ' ' << static_cast<int>(s.orientation()) << ' '
             << s.ship_number() << '\n';
@@ -456,45 +453,81 @@ void PlayingField::save(std::ostream& out) const {
 
 
 void PlayingField::load(std::istream& in) {
+    int version = 1;
+    if ((in >> std::ws).peek() == 'v') {
+        in.get();
+        in >> version;
+        if (!in || version < 2 || version > kSaveFormatVersion) {
+            throw std::runtime_error("Неподдерживаемая версия сохранения поля: " + std::to_string(version));
+        }
+    }
+
     in >> x_size_ >> y_size_;
     in >> count_ >> is_in_replacement_mode_;
+    CheckFieldSize(x_size_, y_size_);
 
-    real_grid_.assign(y_size_, std::vector<Cell>(x_size_, Cell(CellState::EMPTY)));
-    visible_grid_.assign(y_size_, std::vector<Cell>(x_size_, Cell(CellState::UNKNOWN)));
-    scanned_overlay_.assign(y_size_, std::vector<bool>(x_size_, false));
+    storage_ = std::make_shared<Storage>();
+    Storage& data = *storage_;
+    data.grid.assign(static_cast<size_t>(x_size_) * y_size_, kEmptyCell);
 
+    occupied_.Clear();
     for (int y = 0; y < y_size_; ++y) {
         for (int x = 0; x < x_size_; ++x) {
             int cell_state_value, ship_index, segment_index;
             in >> cell_state_value >> ship_index >> segment_index;
-            real_grid_[y][x].set_state(static_cast<CellState>(cell_state_value));
-            real_grid_[y][x].set_ship_index(ship_index);
-            real_grid_[y][x].set_segment_index(segment_index);
+            Cell& cell = mutable_grid_cell(x, y);
+            cell.set_state(static_cast<CellState>(cell_state_value));
+            cell.set_ship_index(ship_index);
+            cell.set_segment_index(segment_index);
+            if (cell.IsShip()) occupied_.Set(x, y);
         }
     }
 
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            int cell_state_value, ship_index, segment_index;
-            in >> cell_state_value >> ship_index >> segment_index;
-            visible_grid_[y][x].set_state(static_cast<CellState>(cell_state_value));
-            visible_grid_[y][x].set_ship_index(ship_index);
-            visible_grid_[y][x].set_segment_index(segment_index);
+    auto load_mask = [&](Bitboard& mask) {
+        mask.Clear();
+        for (int y = 0; y < y_size_; ++y) {
+            for (int x = 0; x < x_size_; ++x) {
+                int value;
+                in >> value;
+                if (value != 0) mask.Set(x, y);
+            }
+        }
+    };
+    if (version == 1) {
+        revealed_.Clear();
+        for (int y = 0; y < y_size_; ++y) {
+            for (int x = 0; x < x_size_; ++x) {
+                int visible_state, ship_index, segment_index;
+                in >> visible_state >> ship_index >> segment_index;
+                if (visible_state != static_cast<int>(CellState::UNKNOWN)) revealed_.Set(x, y);
+            }
         }
+    } else {
+        load_mask(revealed_);
     }
+    load_mask(scanned_);
 
-    for (int y = 0; y < y_size_; ++y) {
-        for (int x = 0; x < x_size_; ++x) {
-            int scanned_value;
-            in >> scanned_value;
-            scanned_overlay_[y][x] = (scanned_value != 0);
+    // Номер корабля в файле совпадает с номером слота. В старых сохранениях номера снятых
+    // кораблей могли устареть, такие корабли занимают первый свободный слот.
+    auto claim_slot = [&](int number, Ship&& s, bool placed) -> bool {
+        if (number < 0 || static_cast<size_t>(number) > data.ships.size()) return false;
+        if (static_cast<size_t>(number) == data.ships.size()) {
+            data.ships.push_back(ShipSlot{std::move(s), 0, placed});
+            return true;
         }
-    }
+        if (data.ships[number].placed || data.ships[number].ship.ship_number() >= 0) return false;
+        data.ships[number] = ShipSlot{std::move(s), 0, placed};
+        return true;
+    };
+    auto reserve_up_to = [&](int number) {
+        const Ship hole(Position(), Orientation::HORIZONTAL, 1, -1);
+        while (number >= 0 && static_cast<size_t>(number) > data.ships.size()) {
+            data.ships.push_back(ShipSlot{hole, 0, false});
+        }
+    };
 
     size_t ship_count;
     in >> ship_count;
-    ships_.clear();
-    ships_.reserve(ship_count);
     for (size_t i = 0; i < ship_count; ++i) {
         int x, y, size, orientation_value, number, destroyed_segments, hit_count;
         in >> x >> y >> size >> orientation_value >> number >> destroyed_segments >> hit_count;
@@ -511,13 +544,15 @@ void PlayingField::load(std::istream& in) {
         s.set_destroyed_segments(destroyed_segments);
         s.set_hit_count(hit_count);
 
-        ships_.push_back(std::move(s));
+        reserve_up_to(number);
+        if (!claim_slot(number, std::move(s), true)) {
+            throw std::runtime_error("Некорректный номер корабля в сохранении: " + std::to_string(number));
+        }
     }
     
     size_t removed_count;
     in >> removed_count;
-    removed_ships_.clear();
-    removed_ships_.reserve(removed_count);
+    std::vector<Ship> unnumbered;
     for (size_t i = 0; i < removed_count; ++i) {
         int x, y, size, orientation_value, number;
         in >> x >> y >> size >> orientation_value >> number;
@@ -528,8 +563,36 @@ void PlayingField::load(std::istream& in) {
             in >> segment_value;
             s.set_segment_state(j, static_cast<SegmentState>(segment_value));
         }
-        removed_ships_.push_back(std::move(s));
+        if (claim_slot(number, Ship(s), false)) {
+            data.free_slots.push_back(number);
+        } else {
+            data.free_slots.push_back(-1);
+            unnumbered.push_back(s);
+        }
     }
+
+    size_t next_unnumbered = 0;
+    for (int& index : data.free_slots) {
+        if (index >= 0) continue;
+        Ship& s = unnumbered[next_unnumbered++];
+        index = static_cast<int>(data.ships.size());
+        for (size_t slot = 0; slot < data.ships.size(); ++slot) {
+            if (!data.ships[slot].placed && data.ships[slot].ship.ship_number() < 0) {
+                index = static_cast<int>(slot);
+                break;
+            }
+        }
+        s.set_ship_number(index);
+        claim_slot(index, std::move(s), false);
+    }
+
+    for (const ShipSlot& slot : data.ships) {
+        if (slot.ship.ship_number() < 0) {
+            throw std::runtime_error("Некорректные номера кораблей в сохранении");
+        }
+    }
+
+    RebuildFleet();
 }
 
 
@@ -549,29 +612,64 @@ int PlayingField::y_size() const {
 
 
 int PlayingField::removed_ship_size() const {
-    return removed_ships_.back().ship_size();
+    return storage_->ships[storage_->free_slots.back()].ship.ship_size();
 }
 
 
-const Cell& PlayingField::visible_cell(int x, int y) const {
+Cell PlayingField::visible_cell(int x, int y) const {
     if (!IsValid(x, y, x_size_, y_size_)) {
         throw ShipOutOfBoundsException(x, y, x_size_, y_size_);
     }
-    return visible_grid_[y][x];
+    // Открытая клетка выглядит так же, как на реальном поле, остальные — неизвестны.
+    return revealed_.Test(x, y) ? grid_cell(x, y) : Cell(CellState::UNKNOWN);
+}
+
+
+bool PlayingField::IsVisibleSegmentDestroyed(int x, int y) const {
+    if (!IsValid(x, y, x_size_, y_size_) || !revealed_.Test(x, y)) return false;
+    const Cell& cell = grid_cell(x, y);
+    if (!cell.IsShip() || !IsShipPlaced(cell.ship_index())) return false;
+    return storage_->ships[cell.ship_index()].ship.segment_state(cell.segment_index()) == SegmentState::DESTROYED;
 }
 
 
 const Ship& PlayingField::ship(int index) const {
-    if (index < 0 || static_cast<size_t>(index) >= ships_.size()) {
+    if (!IsShipPlaced(index)) {
         throw std::out_of_range("Недопустимый индекс корабля");
     }
-    return ships_[index];
+    return storage_->ships[index].ship;
+}
+
+
+int PlayingField::ship_slot_count() const {
+    return static_cast<int>(storage_->ships.size());
+}
+
+
+bool PlayingField::IsShipPlaced(int index) const {
+    return index >= 0 && static_cast<size_t>(index) < storage_->ships.size() && storage_->ships[index].placed;
+}
+
+
+ShipHandle PlayingField::ship_handle(int index) const {
+    if (!IsShipPlaced(index)) return ShipHandle{};
+    return ShipHandle{index, storage_->ships[index].generation};
+}
+
+
+bool PlayingField::IsHandleValid(const ShipHandle& handle) const {
+    return IsShipPlaced(handle.index) && storage_->ships[handle.index].generation == handle.generation;
+}
+
+
+const FleetIndex& PlayingField::fleet() const {
+    return storage_->fleet;
 }
 
 
 void PlayingField::set_cell_visible(int x, int y) { 
     if (IsValid(x, y, x_size_, y_size_)) {
-        scanned_overlay_[y][x] = true;
+        scanned_.Set(x, y);
     }
 }
 
@@ -579,16 +677,38 @@ void PlayingField::set_cell_visible(int x, int y) {
 bool PlayingField::ship_info_at(int x, int y,
                                  int& ship_index, int& segment_index, int& ship_size,
                                  SegmentState& segment_state, Orientation& orientation) const {
-    for (size_t i = 0; i < ships_.size(); ++i) {
-        int index = ships_[i].segment_index(Position(x, y));
-        if (index >= 0) {
-            ship_index = static_cast<int>(i);
-            segment_index = index;
-            ship_size = ships_[i].ship_size();
-            segment_state = ships_[i].segment_state(index);
-            orientation = ships_[i].orientation();
-            return true;
-        }
+    if (!IsValid(x, y, x_size_, y_size_)) return false;
+
+    // Клетка реального поля уже знает свой корабль и сегмент, перебирать флот не нужно.
+    const Cell& cell = grid_cell(x, y);
+    const int index = cell.ship_index();
+    if (!cell.IsShip() || !IsShipPlaced(index)) {
+        return false;
+    }
+
+    const Ship& found = storage_->ships[index].ship;
+    ship_index = index;
+    segment_index = cell.segment_index();
+    ship_size = found.ship_size();
+    segment_state = found.segment_state(segment_index);
+    orientation = found.orientation();
+    return true;
+}
+
+
+Cell& PlayingField::mutable_grid_cell(int x, int y) {
+    return MutableStorage().grid[static_cast<size_t>(y) * x_size_ + x];
+}
+
+
+const Cell& PlayingField::grid_cell(int x, int y) const {
+    return storage_->grid[static_cast<size_t>(y) * x_size_ + x];
+}
+
+
+PlayingField::Storage& PlayingField::MutableStorage() {
+    if (storage_.use_count() > 1) {
+        storage_ = std::make_shared<Storage>(*storage_);
     }
-    return false;
+    return *storage_;
 }
@@ -5,12 +5,38 @@
 #include <memory>
 #include <random>
 #include <chrono>
+#include <cstdint>
 #include "Ship.h"
 #include "Cell.h"
 #include "ShipManager.h"
+#include "Bitboard.h"
+#include "FleetIndex.h"
+#include "FleetPlacer.h"
+#include "PlacementIndex.h"
+#include "PlacementStrategy.h"
+#include "LayoutSampler.h"
+#include "LayoutPool.h"
+#include "Random.h"
 #include <functional> 
 
 
+// Результат проверки места под корабль: можно ставить или почему нельзя.
+enum class PlacementStatus : std::uint8_t {
+    OK,
+    INVALID_SIZE,
+    OUT_OF_BOUNDS,
+    OVERLAP,
+    TOO_CLOSE
+};
+
+
+// Стабильная ссылка на корабль поля. Поколение растёт при каждом снятии корабля,
+// поэтому ссылка, взятая до снятия, после него перестаёт быть действительной.
+struct ShipHandle {
+    int index = -1;
+    std::uint32_t generation = 0;
+};
+
 
 class PlayingField {
 public:
@@ -25,7 +51,9 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const PlayingField& field);
     friend std::istream& operator>>(std::istream& is, PlayingField& field);
 
-    bool SetRandomShips(const ShipManager& manager, size_t max_attempts = 10000);
+    // Расставляет флот manager вокруг уже стоящих кораблей так, как решит strategy.
+    bool SetRandomShips(const ShipManager& manager, Rng& rng, const PlacementStrategy& strategy);
+    PlacementStatus CanPlace(int x, int y, int size, Orientation orientation) const noexcept;
     void MoveShip(int x, int y, int size, Orientation orientation);
     bool PlaceRemovedShip(int x, int y, int size, Orientation orientation);
     bool PlaceNewShip(int x, int y, int size, Orientation orientation);
@@ -45,7 +73,6 @@ public:
     void ClearField();
     void ClearShip(int x, int y);
     void ReturnStartState();
-    void UpdateShipNumbersAfterRemoval(int removed_index);
 
     void save(std::ostream& out) const;
     void load(std::istream& in);
@@ -55,8 +82,16 @@ public:
     int y_size() const;
     int removed_ship_size() const;
     
-    const Cell& visible_cell(int x, int y) const;
+    Cell visible_cell(int x, int y) const;
+    // Открыта ли клетка с уничтоженным сегментом. Вместе с visible_cell это всё, что противник
+    // видит на поле: подбитый один раз сегмент и уничтоженный он различает.
+    bool IsVisibleSegmentDestroyed(int x, int y) const;
     const Ship& ship(int index) const;
+    int ship_slot_count() const;
+    bool IsShipPlaced(int index) const;
+    ShipHandle ship_handle(int index) const;
+    bool IsHandleValid(const ShipHandle& handle) const;
+    const FleetIndex& fleet() const;
     
     void set_cell_visible(int x, int y);
 
@@ -64,11 +99,37 @@ public:
                         SegmentState& segment_state, Orientation& orientation) const;
 
 private:
-    std::vector<std::vector<Cell>> real_grid_;
-    std::vector<std::vector<Cell>> visible_grid_;
-    std::vector<std::vector<bool>> scanned_overlay_;
-    std::vector<Ship> ships_;
-    std::vector<Ship> removed_ships_;
+    // Слот корабля. Номер корабля совпадает с номером слота и не меняется,
+    // снятый корабль остаётся в своём слоте до повторной расстановки.
+    struct ShipSlot {
+        Ship ship;
+        std::uint32_t generation;
+        bool placed;
+    };
+
+    // Тяжёлая часть поля. Копии PlayingField делят одно хранилище, а изменяющие
+    // методы получают его через MutableStorage, которое копирует общее хранилище.
+    struct Storage {
+        // Поле хранится одним буфером по строкам: клетка (x, y) лежит по индексу y * x_size_ + x.
+        std::vector<Cell> grid;
+        std::vector<ShipSlot> ships;
+        // Слоты снятых кораблей; последний будет расставлен первым.
+        std::vector<int> free_slots;
+        FleetIndex fleet;
+    };
+
+    const Cell& grid_cell(int x, int y) const;
+    // Клетка для записи: сначала отделяет хранилище от копий.
+    Cell& mutable_grid_cell(int x, int y);
+    Storage& MutableStorage();
+    void RebuildFleet();
+
+    std::shared_ptr<Storage> storage_;
+    // Битовые слои поля: клетки кораблей, клетки, открытые противнику выстрелами
+    // и потоплением (по ним и реальной сетке строится видимое поле), и клетки, открытые сканером.
+    Bitboard occupied_;
+    Bitboard revealed_;
+    Bitboard scanned_;
 
     int x_size_;
     int y_size_;
@@ -0,0 +1,272 @@
+#include "PosteriorSampler.h"
+#include <algorithm>
+
+
+
+namespace {
+
+// Во сколько раз попыток может быть больше, чем нужно расстановок, пока часть не сдастся.
+constexpr int kAttemptsPerSample = 20;
+// Как часто часть раунда смотрит на часы.
+constexpr int kAttemptsPerClockCheck = 16;
+
+}
+
+
+PosteriorSampler::PosteriorSampler(const PosteriorSettings& settings) : settings_(settings) {
+    settings_.samples = std::max(settings_.samples, 1);
+    if (settings_.threads <= 0) {
+        settings_.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    settings_.threads = std::min(settings_.threads, kChunks);
+
+    // Вызывающий поток тоже разбирает части, поэтому рабочих на один меньше.
+    for (int i = 1; i < settings_.threads; ++i) {
+        workers_.emplace_back(&PosteriorSampler::WorkerLoop, this);
+    }
+}
+
+
+PosteriorSampler::~PosteriorSampler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+
+const PosteriorSettings& PosteriorSampler::settings() const {
+    return settings_;
+}
+
+
+bool PosteriorSampler::ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y, Deadline deadline) {
+    if (observation.ChooseDamagedSegment(rng, x, y)) {
+        return true;
+    }
+
+    Occupancy occupancy;
+    if (Estimate(observation, rng, occupancy, deadline) == 0) {
+        return observation.ChooseTarget(rng, x, y);
+    }
+
+    // Среди самых часто занятых клеток каждая выбирается с равной вероятностью.
+    double best = 0.0;
+    std::uint32_t ties = 0;
+    int cell = -1;
+    Bitboard unknown = snapshot_.unknown;
+    for (int bit = unknown.FirstSet(); bit >= 0; bit = unknown.FirstSet()) {
+        unknown.Reset(bit % Bitboard::kStride, bit / Bitboard::kStride);
+        const double weight = occupancy[bit];
+        if (weight == 0.0 || weight < best) continue;
+        if (weight > best) {
+            best = weight;
+            ties = 0;
+        }
+        if (UniformBelow(rng, ++ties) == 0) cell = bit;
+    }
+    if (cell < 0) {
+        return observation.ChooseTarget(rng, x, y);
+    }
+
+    x = cell % Bitboard::kStride;
+    y = cell / Bitboard::kStride;
+    return true;
+}
+
+
+int PosteriorSampler::Estimate(const AIObservation& observation, Rng& rng, Occupancy& occupancy, Deadline deadline) {
+    const int x_size = observation.x_size();
+    const int y_size = observation.y_size();
+
+    snapshot_.open_hits = observation.hits().AndNot(observation.sunk());
+    snapshot_.unknown = BoardMask(x_size, y_size).AndNot(observation.water() | observation.hits());
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        const PlacementIndex& index = PlacementIndex::Get(x_size, y_size, size);
+        snapshot_.indexes[size] = &index;
+        snapshot_.alive[size] = observation.alive_ships_of_size(size);
+        snapshot_.is_valid[size].reset();
+        int count = 0;
+        for (int i = 0; i < index.count(); ++i) {
+            if (!observation.placement_valid(size, i)) continue;
+            snapshot_.valid[size][count++] = static_cast<std::int16_t>(i);
+            snapshot_.is_valid[size].set(static_cast<std::size_t>(i));
+        }
+        snapshot_.valid_count[size] = count;
+    }
+
+    // Из rng берётся одно число на ход, сколько бы раундов ни успело пройти.
+    Rng seeds(rng());
+    deadline_ = deadline;
+    occupancy.fill(0);
+    int accepted = 0;
+    for (int requested = 0; requested < settings_.samples && std::chrono::steady_clock::now() < deadline;) {
+        const int round = std::min(kRoundSamples, settings_.samples - requested);
+        for (int i = 0; i < kChunks; ++i) {
+            chunks_[i].seed = seeds();
+            chunks_[i].samples = round / kChunks + (i < round % kChunks ? 1 : 0);
+        }
+        RunRound();
+        if (late_.load()) {
+            break;
+        }
+        requested += round;
+
+        // Части складываются по порядку, поэтому результат не зависит от того, какой поток что посчитал.
+        for (const Chunk& chunk : chunks_) {
+            accepted += chunk.accepted;
+            for (int cell = 0; cell < kCells; ++cell) occupancy[cell] += chunk.occupancy[cell];
+        }
+    }
+    return accepted;
+}
+
+
+void PosteriorSampler::RunRound() {
+    next_chunk_.store(0);
+    late_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        busy_workers_ = static_cast<int>(workers_.size());
+    }
+    wake_.notify_all();
+    RunChunks();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_workers_ == 0; });
+    }
+}
+
+
+void PosteriorSampler::WorkerLoop() {
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+            return;
+        }
+        seen = generation_;
+
+        lock.unlock();
+        RunChunks();
+        lock.lock();
+
+        if (--busy_workers_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+
+void PosteriorSampler::RunChunks() {
+    for (int i = next_chunk_.fetch_add(1); i < kChunks && !late_.load(); i = next_chunk_.fetch_add(1)) {
+        SampleChunk(chunks_[i]);
+    }
+}
+
+
+void PosteriorSampler::SampleChunk(Chunk& chunk) {
+    Rng rng(chunk.seed);
+    chunk.occupancy.fill(0);
+    chunk.accepted = 0;
+
+    const bool timed = deadline_ != Deadline::max();
+    const int max_attempts = chunk.samples * kAttemptsPerSample;
+    Bitboard ships;
+    double weight = 0.0;
+    for (int attempt = 0; attempt < max_attempts && chunk.accepted < chunk.samples; ++attempt) {
+        if (timed && attempt % kAttemptsPerClockCheck == 0 && std::chrono::steady_clock::now() >= deadline_) {
+            late_.store(true);
+            return;
+        }
+        if (!SampleLayout(snapshot_, rng, ships, weight)) continue;
+        ++chunk.accepted;
+        Bitboard cells = ships & snapshot_.unknown;
+        for (int w = 0; w < Bitboard::kWords; ++w) {
+            for (std::uint64_t word = cells.word(w); word != 0; word &= word - 1) {
+                chunk.occupancy[w * 64 + __builtin_ctzll(word)] += weight;
+            }
+        }
+    }
+}
+
+
+bool PosteriorSampler::SampleLayout(const Snapshot& snapshot, Rng& rng, Bitboard& ships, double& weight) {
+    std::array<int, Ship::kMaxSize + 1> remaining = snapshot.alive;
+    Bitboard forbidden;
+    ships = Bitboard();
+    weight = 1.0;
+
+    auto place = [&](int size, const Placement& placement) {
+        forbidden |= placement.halo;
+        ships |= placement.ship;
+        remaining[size]--;
+    };
+
+    // Первое ненакрытое попадание накрывается равновероятной позицией живого корабля через него.
+    // Какой корабль его накрывает, определяется самой расстановкой, поэтому путь к ней один.
+    Bitboard uncovered = snapshot.open_hits;
+    while (uncovered.Any()) {
+        const int bit = uncovered.FirstSet();
+        const int hx = bit % Bitboard::kStride;
+        const int hy = bit / Bitboard::kStride;
+
+        std::array<const Placement*, 2 * Ship::kMaxSize * Ship::kMaxSize> candidates;
+        std::array<int, 2 * Ship::kMaxSize * Ship::kMaxSize> candidate_sizes;
+        int count = 0;
+        for (int size = 1; size <= Ship::kMaxSize; ++size) {
+            if (remaining[size] == 0) continue;
+            const PlacementIndex& index = *snapshot.indexes[size];
+            for (int k = 0; k < size; ++k) {
+                for (Orientation orientation : {Orientation::HORIZONTAL, Orientation::VERTICAL}) {
+                    if (size == 1 && orientation == Orientation::VERTICAL) continue;
+                    const int sx = (orientation == Orientation::HORIZONTAL) ? hx - k : hx;
+                    const int sy = (orientation == Orientation::VERTICAL) ? hy - k : hy;
+                    const Placement* placement = index.Find(sx, sy, orientation);
+                    if (placement == nullptr || placement->ship.Intersects(forbidden) ||
+                        !snapshot.is_valid[size].test(static_cast<std::size_t>(placement - index.begin()))) {
+                        continue;
+                    }
+                    candidates[count] = placement;
+                    candidate_sizes[count] = size;
+                    ++count;
+                }
+            }
+        }
+        if (count == 0) {
+            return false;
+        }
+
+        const int chosen = static_cast<int>(UniformBelow(rng, static_cast<std::uint32_t>(count)));
+        weight *= count;
+        place(candidate_sizes[chosen], *candidates[chosen]);
+        uncovered = uncovered.AndNot(candidates[chosen]->ship);
+    }
+
+    // Остальные корабли — от больших к меньшим, каждый на равновероятную из ещё свободных
+    // согласованных позиций. Корабли одного размера можно поставить в любом из k! порядков,
+    // и каждый порядок — отдельный путь к той же расстановке.
+    std::array<std::int16_t, 2 * Bitboard::kMaxSide * Bitboard::kMaxSide> free_positions;
+    for (int size = Ship::kMaxSize; size >= 1; --size) {
+        const PlacementIndex& index = *snapshot.indexes[size];
+        for (int placed = 1; remaining[size] > 0; ++placed) {
+            int count = 0;
+            for (int k = 0; k < snapshot.valid_count[size]; ++k) {
+                const std::int16_t position = snapshot.valid[size][k];
+                if (!index[position].ship.Intersects(forbidden)) free_positions[count++] = position;
+            }
+            if (count == 0) {
+                return false;
+            }
+            weight *= static_cast<double>(count) / placed;
+            place(size, index[free_positions[UniformBelow(rng, static_cast<std::uint32_t>(count))]]);
+        }
+    }
+    return true;
+}
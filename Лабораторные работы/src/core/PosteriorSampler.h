@@ -0,0 +1,114 @@
+#ifndef BATTLESHIP_CORE_POSTERIORSAMPLER_H_
+#define BATTLESHIP_CORE_POSTERIORSAMPLER_H_
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AIObservation.h"
+#include "Bitboard.h"
+#include "PlacementIndex.h"
+#include "Random.h"
+#include "Ship.h"
+
+struct PosteriorSettings {
+    // Сколько полных расстановок флота собирать на один ход, если раньше не кончится время.
+    int samples = 4000;
+    // Сколько потоков считает выборки вместе с вызывающим; 0 — по числу ядер.
+    int threads = 0;
+};
+
+
+// ИИ, который стреляет туда, где корабль стоит чаще всего среди случайных расстановок
+// оставшегося флота, согласованных со всем, что ИИ уже видел.
+//
+// Расстановка собирается так: сначала каждое попадание в непотопленный корабль накрывается
+// согласованной позицией живого корабля, затем остальные корабли ставятся на случайные
+// согласованные позиции так, чтобы не касаться друг друга. Неудачная расстановка отбрасывается.
+// Такие расстановки выпадают неравновероятно, поэтому каждая входит в оценку с весом,
+// обратным вероятности её собрать: взвешенная занятость клеток — несмещённая (с точностью
+// до нормировки) оценка по всем согласованным расстановкам, как при равномерной выборке.
+// Выборки идут раундами по kRoundSamples, каждый раунд делится на kChunks частей со своими
+// зёрнами; части разбирают рабочие потоки и сам вызывающий, а итог складывается в порядке
+// частей, поэтому ход зависит только от rng и числа законченных раундов, а не от числа потоков.
+// Раунды идут, пока не набрано settings.samples расстановок или не наступил срок; раунд,
+// который не успел к сроку, отбрасывается целиком. Без срока ход зависит только от rng.
+// Вся память выделяется в конструкторе, на выборку ничего не выделяется.
+class PosteriorSampler {
+public:
+    static constexpr int kChunks = 32;
+    static constexpr int kRoundSamples = 1024;
+    static constexpr int kCells = Bitboard::kWords * 64;
+
+    using Occupancy = std::array<double, kCells>;
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    explicit PosteriorSampler(const PosteriorSettings& settings = PosteriorSettings());
+    ~PosteriorSampler();
+
+    PosteriorSampler(const PosteriorSampler&) = delete;
+    PosteriorSampler& operator=(const PosteriorSampler&) = delete;
+
+    // Цель следующего выстрела: сначала подбитые сегменты, затем самая часто занятая неизвестная
+    // клетка. Если к сроку ни одна расстановка не собралась, ход выбирается по плотности позиций.
+    bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                      Deadline deadline = Deadline::max());
+
+    // Суммарный вес собранных расстановок, в которых занята каждая неизвестная клетка.
+    // Возвращает число собранных расстановок.
+    int Estimate(const AIObservation& observation, Rng& rng, Occupancy& occupancy,
+                 Deadline deadline = Deadline::max());
+
+    const PosteriorSettings& settings() const;
+
+private:
+    // Всё, что нужно для выборок на этом ходу; только для чтения во время выборок.
+    struct Snapshot {
+        std::array<const PlacementIndex*, Ship::kMaxSize + 1> indexes{};
+        std::array<int, Ship::kMaxSize + 1> alive{};
+        // Номера согласованных позиций для каждого размера.
+        std::array<std::array<std::int16_t, 2 * Bitboard::kMaxSide * Bitboard::kMaxSide>, Ship::kMaxSize + 1> valid{};
+        std::array<int, Ship::kMaxSize + 1> valid_count{};
+        std::array<std::bitset<2 * Bitboard::kMaxSide * Bitboard::kMaxSide>, Ship::kMaxSize + 1> is_valid;
+        Bitboard open_hits;
+        Bitboard unknown;
+    };
+
+    struct Chunk {
+        std::uint64_t seed = 0;
+        int samples = 0;
+        int accepted = 0;
+        Occupancy occupancy{};
+    };
+
+    void WorkerLoop();
+    // Раздаёт части раунда рабочим, считает вместе с ними и ждёт, пока все закончат.
+    void RunRound();
+    void RunChunks();
+    void SampleChunk(Chunk& chunk);
+    // Собирает расстановку и её вес — величину, обратную вероятности её собрать.
+    static bool SampleLayout(const Snapshot& snapshot, Rng& rng, Bitboard& ships, double& weight);
+
+    PosteriorSettings settings_;
+    Snapshot snapshot_;
+    std::array<Chunk, kChunks> chunks_;
+    std::atomic<int> next_chunk_{0};
+    Deadline deadline_ = Deadline::max();
+    // Срок наступил посреди раунда.
+    std::atomic<bool> late_{false};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    int busy_workers_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "Random.h"
+#include <random>
+
+
+
+namespace {
+
+std::uint64_t SplitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+}
+
+
+Xoshiro256::Xoshiro256(std::uint64_t seed) {
+    // Состояние заполняется через SplitMix64, чтобы даже соседние зёрна давали несвязанные потоки.
+    std::uint64_t state = seed;
+    for (auto& word : s_) {
+        word = SplitMix64(state);
+    }
+}
+
+
+void Xoshiro256::Jump() {
+    static constexpr std::uint64_t kJump[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                              0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    std::array<std::uint64_t, 4> jumped{};
+    for (std::uint64_t mask : kJump) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (mask & (std::uint64_t{1} << bit)) {
+                for (int i = 0; i < 4; ++i) jumped[i] ^= s_[i];
+            }
+            (*this)();
+        }
+    }
+    s_ = jumped;
+}
+
+
+std::ostream& operator<<(std::ostream& os, const Xoshiro256& rng) {
+    os << rng.s_[0] << ' ' << rng.s_[1] << ' ' << rng.s_[2] << ' ' << rng.s_[3];
+    return os;
+}
+
+
+std::istream& operator>>(std::istream& is, Xoshiro256& rng) {
+    std::array<std::uint64_t, 4> s{};
+    if (is >> s[0] >> s[1] >> s[2] >> s[3]) {
+        rng.s_ = s;
+    }
+    return is;
+}
+
+
+GameRandom::GameRandom(std::uint64_t seed) : seed_(seed), placement_(seed), ai_(seed), abilities_(seed) {
+    ai_.Jump();
+    abilities_.Jump();
+    abilities_.Jump();
+}
+
+
+std::uint64_t GameRandom::FreshSeed() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
+
+
+std::uint64_t GameRandom::seed() const {
+    return seed_;
+}
+
+
+Rng& GameRandom::placement() {
+    return placement_;
+}
+
+
+Rng& GameRandom::ai() {
+    return ai_;
+}
+
+
+Rng& GameRandom::abilities() {
+    return abilities_;
+}
+
+
+std::ostream& operator<<(std::ostream& os, const GameRandom& random) {
+    os << random.seed_ << '\n'
+       << random.placement_ << '\n'
+       << random.ai_ << '\n'
+       << random.abilities_ << '\n';
+    return os;
+}
+
+
+std::istream& operator>>(std::istream& is, GameRandom& random) {
+    GameRandom loaded(0);
+    if (is >> loaded.seed_ >> loaded.placement_ >> loaded.ai_ >> loaded.abilities_) {
+        random = loaded;
+    }
+    return is;
+}
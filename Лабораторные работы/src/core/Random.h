@@ -0,0 +1,91 @@
+#ifndef BATTLESHIP_CORE_RANDOM_H_
+#define BATTLESHIP_CORE_RANDOM_H_
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+// Генератор xoshiro256**: четыре слова состояния, несколько сдвигов на число.
+// Подходит для std::shuffle и std::uniform_int_distribution.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = Rotl(s_[3], 45);
+        return result;
+    }
+
+    // Сдвигает генератор на 2^128 чисел вперёд: так из одного зерна получаются непересекающиеся потоки.
+    void Jump();
+
+    bool operator==(const Xoshiro256& other) const { return s_ == other.s_; }
+    bool operator!=(const Xoshiro256& other) const { return !(*this == other); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Xoshiro256& rng);
+    friend std::istream& operator>>(std::istream& is, Xoshiro256& rng);
+
+private:
+    static constexpr std::uint64_t Rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::array<std::uint64_t, 4> s_;
+};
+
+using Rng = Xoshiro256;
+
+
+// Равномерное число из [0, range) по методу Лемира: без смещения и почти всегда без деления.
+inline std::uint32_t UniformBelow(Rng& rng, std::uint32_t range) {
+    std::uint64_t product = (rng() >> 32) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < range) {
+        const std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            product = (rng() >> 32) * range;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+
+// Случайность одной партии. Из зерна партии получаются отдельные потоки для расстановки
+// кораблей, ходов ИИ и способностей, поэтому партию можно воспроизвести по зерну,
+// и лишний вызов в одной подсистеме не сдвигает случайность в других.
+class GameRandom {
+public:
+    explicit GameRandom(std::uint64_t seed = FreshSeed());
+
+    // Новое зерно из std::random_device; вызывается один раз на партию.
+    static std::uint64_t FreshSeed();
+
+    std::uint64_t seed() const;
+    Rng& placement();
+    Rng& ai();
+    Rng& abilities();
+
+    friend std::ostream& operator<<(std::ostream& os, const GameRandom& random);
+    friend std::istream& operator>>(std::istream& is, GameRandom& random);
+
+private:
+    std::uint64_t seed_;
+    Rng placement_;
+    Rng ai_;
+    Rng abilities_;
+};
+
+#endif
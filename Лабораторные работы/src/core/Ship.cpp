@@ -1,68 +1,28 @@
 #include "Ship.h"
 #include <stdexcept>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Ship>::value, "Ship должен копироваться через memcpy");
 
 
 Ship::Ship(Position start, Orientation orient, int size, int number)
     : start_position_(start),
       ship_size_(size),
       ship_orientation_(orient),
-      segments_(size, SegmentState::INTACT),
       ship_number_(number),
       destroyed_segments_(0),
-      hit_count_(0) {
-    if (size < 1 || size > 4) {
+      hit_count_(0),
+      alive_segments_(size) {
+    if (size < 1 || size > kMaxSize) {
         throw std::invalid_argument("Размер корабля должен быть от 1 до 4");
     }
-}
-
-Ship::Ship(const Ship& other)
-    : start_position_(other.start_position_),
-      ship_size_(other.ship_size_),
-      ship_orientation_(other.ship_orientation_),
-      segments_(other.segments_),
-      ship_number_(other.ship_number_),
-      destroyed_segments_(other.destroyed_segments_),
-      hit_count_(other.hit_count_) {}
-
-Ship::Ship(Ship&& other) noexcept
-    : start_position_(other.start_position_),
-      ship_size_(other.ship_size_),
-      ship_orientation_(other.ship_orientation_),
-      segments_(std::move(other.segments_)),
-      ship_number_(other.ship_number_),
-      destroyed_segments_(other.destroyed_segments_),
-      hit_count_(other.hit_count_) {}
-
-Ship& Ship::operator=(const Ship& other) {
-    if (this != &other) {
-        start_position_ = other.start_position_;
-        ship_size_ = other.ship_size_;
-        ship_orientation_ = other.ship_orientation_;
-        segments_ = other.segments_;
-        ship_number_ = other.ship_number_;
-        destroyed_segments_ = other.destroyed_segments_;
-        hit_count_ = other.hit_count_;
+    segments_.fill(SegmentState::NONE);
+    for (int i = 0; i < size; ++i) {
+        segments_[i] = SegmentState::INTACT;
     }
-    return *this;
-}
-
-Ship& Ship::operator=(Ship&& other) noexcept {
-    if (this != &other) {
-        start_position_ = other.start_position_;
-        ship_size_ = other.ship_size_;
-        ship_orientation_ = other.ship_orientation_;
-        segments_ = std::move(other.segments_);
-        ship_number_ = other.ship_number_;
-        destroyed_segments_ = other.destroyed_segments_;
-        hit_count_ = other.hit_count_;
-    }
-    return *this;
 }
 
 
-Ship::~Ship() {}
-
-
 int Ship::DamageShip(Position position_for_damage, int damage) {
     int index = segment_index(position_for_damage);
     if (index < 0 || index >= ship_size_) {
@@ -82,6 +42,7 @@ int Ship::DamageShip(Position position_for_damage, int damage) {
 void Ship::Hit(int index, int damage) {
     if (segments_[index] == SegmentState::INTACT) {
         segments_[index] = (damage >= 2) ? SegmentState::DESTROYED : SegmentState::DAMAGED;
+        if (damage >= 2) alive_segments_--;
         destroyed_segments_++; 
         hit_count_++;
         return;
@@ -89,6 +50,7 @@ void Ship::Hit(int index, int damage) {
 
     if (segments_[index] == SegmentState::DAMAGED) {
         segments_[index] = SegmentState::DESTROYED;
+        alive_segments_--;
         hit_count_++;
         return;
     }
@@ -96,16 +58,14 @@ void Ship::Hit(int index, int damage) {
 
 
 bool Ship::IsDestroyed() const {
-    for (auto s : segments_) {
-        if (s != SegmentState::DESTROYED) return false;
-    }
-    return true;
+    return alive_segments_ == 0;
 }
 
 
 void Ship::MarkFullyDestroyed() {
-    for (auto& s : segments_) s = SegmentState::DESTROYED;
+    for (int i = 0; i < ship_size_; ++i) segments_[i] = SegmentState::DESTROYED;
     destroyed_segments_ = ship_size_;
+    alive_segments_ = 0;
 }
 
 
@@ -139,7 +99,7 @@ Position Ship::segment_position(int index) const {
 }
 
 
-const std::vector<SegmentState>& Ship::segments() const { 
+const std::array<SegmentState, Ship::kMaxSize>& Ship::segments() const { 
     return segments_; 
 }
 
@@ -175,7 +135,7 @@ void Ship::set_ship_number(int number) {
 
 
 SegmentState Ship::segment_state(int index) const {
-    if (index >= 0 && index < static_cast<int>(segments_.size())) {
+    if (index >= 0 && index < ship_size_) {
         return segments_[index];
     }
     throw std::out_of_range("Сегмент с индексом " + std::to_string(index) + " вне диапазона");
@@ -183,6 +143,8 @@ SegmentState Ship::segment_state(int index) const {
 
 
 void Ship::set_segment_state(int index, SegmentState state){
+    if (segments_[index] == SegmentState::DESTROYED) alive_segments_++;
+    if (state == SegmentState::DESTROYED) alive_segments_--;
     segments_[index] = state;
 }
 
@@ -202,6 +164,11 @@ int Ship::hit_count() const {
 }
 
 
+int Ship::alive_segments() const {
+    return alive_segments_;
+}
+
+
 void Ship::set_hit_count(int count) { 
     hit_count_ = count; 
 }
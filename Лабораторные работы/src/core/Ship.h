@@ -1,5 +1,6 @@
 #ifndef BATTLESHIP_CORE_SHIP_H_
 #define BATTLESHIP_CORE_SHIP_H_
+#include <array>
 #include <vector>
 #include <iostream>
 #include <tuple>
@@ -28,14 +29,13 @@ struct Position {
 };
 
 
+// Корабль хранит сегменты прямо в объекте и тривиально копируется,
+// поэтому копии полей и снимков состояния не выделяют память.
 class Ship {
 public:
+    static constexpr int kMaxSize = 4;
+
     Ship(Position start, Orientation orient, int size, int number);
-    Ship(const Ship& other);
-    Ship(Ship&& other) noexcept;
-    Ship& operator=(const Ship& other);
-    Ship& operator=(Ship&& other) noexcept;
-    ~Ship();
 
     int DamageShip(Position position_for_damage, int damage = 1);
     void Hit(int segment_index, int damage);
@@ -45,7 +45,7 @@ public:
     int ship_size() const;
     int segment_index(Position current) const;
     Position segment_position(int index) const;
-    const std::vector<SegmentState>& segments() const;
+    const std::array<SegmentState, kMaxSize>& segments() const;
 
     Position start_position() const;
     void set_start_position(Position pos);
@@ -62,6 +62,7 @@ public:
     int destroyed_segments() const;
     void set_destroyed_segments(int count);
     int hit_count() const;
+    int alive_segments() const;
     void set_hit_count(int count);
 
     std::tuple<int, SegmentState, Orientation> segment_state(int x, int y) const; 
@@ -70,11 +71,12 @@ private:
     Position start_position_;
     int ship_size_;
     Orientation ship_orientation_;
-    std::vector<SegmentState> segments_;
+    std::array<SegmentState, kMaxSize> segments_;
     int ship_number_;
 
     int destroyed_segments_; 
     int hit_count_;
+    int alive_segments_;
 };
 
 #endif
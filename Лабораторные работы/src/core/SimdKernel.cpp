@@ -0,0 +1,44 @@
+#include "SimdKernel.h"
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATTLESHIP_X86_SIMD_KERNELS 1
+#endif
+
+
+
+bool IsSimdKernelSupported(SimdKernel kernel) {
+    switch (kernel) {
+        case SimdKernel::SCALAR:
+            return true;
+#ifdef BATTLESHIP_X86_SIMD_KERNELS
+        case SimdKernel::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case SimdKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+
+SimdKernel BestSimdKernel() {
+    static const SimdKernel best = [] {
+        for (SimdKernel kernel : {SimdKernel::AVX2, SimdKernel::SSE2}) {
+            if (IsSimdKernelSupported(kernel)) return kernel;
+        }
+        return SimdKernel::SCALAR;
+    }();
+    return best;
+}
+
+
+const char* SimdKernelName(SimdKernel kernel) {
+    switch (kernel) {
+        case SimdKernel::SCALAR: return "scalar";
+        case SimdKernel::SSE2:   return "sse2";
+        case SimdKernel::AVX2:   return "avx2";
+    }
+    return "unknown";
+}
@@ -0,0 +1,17 @@
+#ifndef BATTLESHIP_CORE_SIMDKERNEL_H_
+#define BATTLESHIP_CORE_SIMDKERNEL_H_
+
+// Набор команд, для которого собрана версия векторного кода. SCALAR работает везде,
+// SSE2 и AVX2 — только на x86 и только если процессор их поддерживает.
+enum class SimdKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Лучшая версия, доступная на этом процессоре.
+SimdKernel BestSimdKernel();
+bool IsSimdKernelSupported(SimdKernel kernel);
+const char* SimdKernelName(SimdKernel kernel);
+
+#endif
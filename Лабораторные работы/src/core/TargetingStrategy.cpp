@@ -0,0 +1,125 @@
+#include "TargetingStrategy.h"
+#include <cstdlib>
+#include <sstream>
+
+
+
+const char* RandomTargeting::name() const {
+    return "random";
+}
+
+
+bool RandomTargeting::ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y, Deadline) {
+    if (observation.ChooseDamagedSegment(rng, x, y)) {
+        return true;
+    }
+
+    // Неизвестная клетка выбирается равновероятно: каждая следующая заменяет выбранную с шансом 1/n.
+    std::uint32_t seen = 0;
+    for (int cy = 0; cy < observation.y_size(); ++cy) {
+        for (int cx = 0; cx < observation.x_size(); ++cx) {
+            if (!observation.IsUnknown(cx, cy)) continue;
+            if (UniformBelow(rng, ++seen) == 0) {
+                x = cx;
+                y = cy;
+            }
+        }
+    }
+    return seen > 0;
+}
+
+
+const char* HuntTargeting::name() const {
+    return "hunt";
+}
+
+
+bool HuntTargeting::ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y, Deadline deadline) {
+    if (observation.ChooseDamagedSegment(rng, x, y)) {
+        return true;
+    }
+
+    const Bitboard open = observation.hits().AndNot(observation.sunk());
+    const Bitboard near = (open << 1) | (open >> 1) | (open << Bitboard::kStride) | (open >> Bitboard::kStride);
+    std::uint32_t seen = 0;
+    for (int cy = 0; cy < observation.y_size(); ++cy) {
+        for (int cx = 0; cx < observation.x_size(); ++cx) {
+            if (!near.Test(cx, cy) || !observation.IsUnknown(cx, cy)) continue;
+            if (UniformBelow(rng, ++seen) == 0) {
+                x = cx;
+                y = cy;
+            }
+        }
+    }
+    if (seen > 0) {
+        return true;
+    }
+    return RandomTargeting().ChooseTarget(observation, rng, x, y, deadline);
+}
+
+
+const char* DensityTargeting::name() const {
+    return "density";
+}
+
+
+bool DensityTargeting::ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y, Deadline) {
+    return observation.ChooseTarget(rng, x, y);
+}
+
+
+PosteriorTargeting::PosteriorTargeting(const PosteriorSettings& posterior, const EndgameSettings& endgame)
+        : posterior_settings_(posterior), endgame_solver_(endgame) {}
+
+
+const char* PosteriorTargeting::name() const {
+    return "posterior";
+}
+
+
+bool PosteriorTargeting::ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y, Deadline deadline) {
+    if (observation.ChooseDamagedSegment(rng, x, y)) {
+        return true;
+    }
+    if (endgame_solver_.ChooseTarget(observation, x, y, deadline)) {
+        return true;
+    }
+    if (!posterior_sampler_) {
+        posterior_sampler_ = std::make_unique<PosteriorSampler>(posterior_settings_);
+    }
+    return posterior_sampler_->ChooseTarget(observation, rng, x, y, deadline);
+}
+
+
+std::unique_ptr<TargetingStrategy> MakeTargetingStrategy(const std::string& spec) {
+    if (spec == "random") {
+        return std::make_unique<RandomTargeting>();
+    }
+    if (spec == "hunt") {
+        return std::make_unique<HuntTargeting>();
+    }
+    if (spec == "density") {
+        return std::make_unique<DensityTargeting>();
+    }
+    const std::string posterior = "posterior";
+    if (spec.compare(0, posterior.size(), posterior) == 0) {
+        PosteriorSettings settings;
+        EndgameSettings endgame;
+        settings.threads = 1;
+        std::stringstream in(spec.substr(posterior.size()));
+        std::string field;
+        std::getline(in, field, ':');
+        if (!field.empty()) return nullptr;
+        if (std::getline(in, field, ':')) {
+            settings.samples = std::atoi(field.c_str());
+            if (settings.samples <= 0) return nullptr;
+        }
+        if (std::getline(in, field, ':')) {
+            endgame.max_layouts = std::atoi(field.c_str());
+            if (endgame.max_layouts < 0 || field.empty()) return nullptr;
+        }
+        if (std::getline(in, field)) return nullptr;
+        return std::make_unique<PosteriorTargeting>(settings, endgame);
+    }
+    return nullptr;
+}
@@ -0,0 +1,81 @@
+#ifndef BATTLESHIP_CORE_TARGETINGSTRATEGY_H_
+#define BATTLESHIP_CORE_TARGETINGSTRATEGY_H_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include "AIObservation.h"
+#include "EndgameSolver.h"
+#include "PosteriorSampler.h"
+#include "Random.h"
+
+// Куда ИИ стреляет по тому, что он видит. Стратегия может хранить состояние между ходами,
+// поэтому одна стратегия обслуживает одну партию в одном потоке.
+class TargetingStrategy {
+public:
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    virtual ~TargetingStrategy() = default;
+
+    virtual const char* name() const = 0;
+
+    // Цель следующего выстрела; к сроку ход должен быть выбран, пусть и хуже.
+    // Возвращает false, если стрелять некуда.
+    virtual bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                              Deadline deadline = Deadline::max()) = 0;
+};
+
+
+// Подбитые сегменты, затем случайная неизвестная клетка. Нижняя планка для сравнения стратегий.
+class RandomTargeting : public TargetingStrategy {
+public:
+    const char* name() const override;
+    bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                      Deadline deadline = Deadline::max()) override;
+};
+
+
+// Подбитые сегменты, затем неизвестные клетки по соседству с попаданиями в непотопленный корабль,
+// иначе случайная неизвестная клетка. Тот же стрелок играет в LockstepSimulator.
+class HuntTargeting : public TargetingStrategy {
+public:
+    const char* name() const override;
+    bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                      Deadline deadline = Deadline::max()) override;
+};
+
+
+// Быстрый ход по плотности согласованных позиций (AIObservation::ChooseTarget).
+class DensityTargeting : public TargetingStrategy {
+public:
+    const char* name() const override;
+    bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                      Deadline deadline = Deadline::max()) override;
+};
+
+
+// Подбитые сегменты, затем точный перебор в конце раунда, а если он не нужен или не успел —
+// самая часто занятая клетка среди случайных расстановок оставшегося флота.
+class PosteriorTargeting : public TargetingStrategy {
+public:
+    PosteriorTargeting(const PosteriorSettings& posterior, const EndgameSettings& endgame);
+
+    const char* name() const override;
+    bool ChooseTarget(AIObservation& observation, Rng& rng, int& x, int& y,
+                      Deadline deadline = Deadline::max()) override;
+
+private:
+    PosteriorSettings posterior_settings_;
+    EndgameSolver endgame_solver_;
+    // Рабочие потоки выборок запускаются только к первому ходу, который до них дошёл.
+    std::unique_ptr<PosteriorSampler> posterior_sampler_;
+};
+
+
+// Стратегия по описанию для пакетных прогонов: random, hunt, density или
+// posterior[:расстановок на ход[:расстановок для точного перебора]], где 0 в конце отключает
+// перебор. Выборкам расстановок даётся один поток: ядра заняты другими партиями.
+// Возвращает nullptr, если описание не распознано.
+std::unique_ptr<TargetingStrategy> MakeTargetingStrategy(const std::string& spec);
+
+#endif
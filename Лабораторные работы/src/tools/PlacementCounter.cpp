@@ -0,0 +1,208 @@
+#include "tools/PlacementCounter.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BATTLESHIP_X86_PLACEMENT_KERNELS 1
+#endif
+
+
+
+namespace {
+
+constexpr int kCells = Bitboard::kWords * 64;
+constexpr int kRows = kCells / Bitboard::kStride;
+
+void AddBits(const Bitboard& bits, std::array<std::uint8_t, kCells>& counts) {
+    for (int w = 0; w < Bitboard::kWords; ++w) {
+        for (std::uint64_t word = bits.word(w); word != 0; word &= word - 1) {
+            counts[w * 64 + __builtin_ctzll(word)]++;
+        }
+    }
+}
+
+
+void CountScalar(const Bitboard& free_cells, PlacementCounts& counts) {
+    counts.by_size[0].fill(0);
+    Bitboard horizontal = free_cells;
+    Bitboard vertical = free_cells;
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        std::array<std::uint8_t, kCells>& out = counts.by_size[size];
+        out.fill(0);
+        if (size > 1) {
+            horizontal &= free_cells >> (size - 1);
+            vertical &= free_cells >> ((size - 1) * Bitboard::kStride);
+        }
+        for (int k = 0; k < size; ++k) {
+            AddBits(horizontal << k, out);
+            // У однопалубного корабля вертикальная позиция совпадает с горизонтальной.
+            if (size > 1) AddBits(vertical << (k * Bitboard::kStride), out);
+        }
+    }
+}
+
+
+#ifdef BATTLESHIP_X86_PLACEMENT_KERNELS
+
+// Пустые строки сверху и снизу поля: окна по столбцу читают соседние строки без проверок.
+constexpr int kPad = Ship::kMaxSize;
+
+// По байту на клетку (0 или 1), строка поля — 16 байт подряд.
+struct alignas(32) ByteRows {
+    std::uint8_t rows[kRows + 2 * kPad][Bitboard::kStride];
+};
+
+constexpr std::array<std::uint64_t, 256> MakeExpandTable() {
+    std::array<std::uint64_t, 256> table{};
+    for (int byte = 0; byte < 256; ++byte) {
+        for (int bit = 0; bit < 8; ++bit) {
+            if (byte & (1 << bit)) table[byte] |= std::uint64_t{1} << (8 * bit);
+        }
+    }
+    return table;
+}
+
+// Байт b превращается в восемь байт со значениями его битов (x86 — little-endian).
+constexpr std::array<std::uint64_t, 256> kExpand = MakeExpandTable();
+
+void ExpandRows(const Bitboard& free_cells, ByteRows& out) {
+    std::memset(&out, 0, sizeof(out));
+    for (int y = 0; y < kRows; ++y) {
+        const std::uint64_t row = (free_cells.word(y / 4) >> (Bitboard::kStride * (y % 4))) & 0xFFFF;
+        const std::uint64_t low = kExpand[row & 0xFF];
+        const std::uint64_t high = kExpand[row >> 8];
+        std::memcpy(&out.rows[kPad + y][0], &low, 8);
+        std::memcpy(&out.rows[kPad + y][8], &high, 8);
+    }
+}
+
+
+__attribute__((target("sse2")))
+void CountSse2(const Bitboard& free_cells, PlacementCounts& counts) {
+    ByteRows cells;
+    ExpandRows(free_cells, cells);
+    counts.by_size[0].fill(0);
+
+    // Начала вертикальных позиций длины 2, 3 и 4.
+    ByteRows starts[3];
+    std::memset(starts, 0, sizeof(starts));
+    for (int y = 0; y < kRows; ++y) {
+        const int row = kPad + y;
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(cells.rows[row]));
+        for (int size = 2; size <= Ship::kMaxSize; ++size) {
+            v = _mm_and_si128(v, _mm_load_si128(reinterpret_cast<const __m128i*>(cells.rows[row + size - 1])));
+            _mm_store_si128(reinterpret_cast<__m128i*>(starts[size - 2].rows[row]), v);
+        }
+    }
+
+    for (int y = 0; y < kRows; ++y) {
+        const int row = kPad + y;
+        const __m128i c = _mm_load_si128(reinterpret_cast<const __m128i*>(cells.rows[row]));
+
+        // Начала горизонтальных позиций: свободны клетки x .. x + size - 1.
+        const __m128i h1 = c;
+        const __m128i h2 = _mm_and_si128(h1, _mm_srli_si128(c, 1));
+        const __m128i h3 = _mm_and_si128(h2, _mm_srli_si128(c, 2));
+        const __m128i h4 = _mm_and_si128(h3, _mm_srli_si128(c, 3));
+
+        const __m128i count1 = h1;
+        __m128i count2 = _mm_add_epi8(h2, _mm_slli_si128(h2, 1));
+        __m128i count3 = _mm_add_epi8(_mm_add_epi8(h3, _mm_slli_si128(h3, 1)), _mm_slli_si128(h3, 2));
+        __m128i count4 = _mm_add_epi8(_mm_add_epi8(h4, _mm_slli_si128(h4, 1)),
+                                      _mm_add_epi8(_mm_slli_si128(h4, 2), _mm_slli_si128(h4, 3)));
+
+        for (int k = 0; k < 2; ++k) {
+            count2 = _mm_add_epi8(count2, _mm_load_si128(reinterpret_cast<const __m128i*>(starts[0].rows[row - k])));
+        }
+        for (int k = 0; k < 3; ++k) {
+            count3 = _mm_add_epi8(count3, _mm_load_si128(reinterpret_cast<const __m128i*>(starts[1].rows[row - k])));
+        }
+        for (int k = 0; k < 4; ++k) {
+            count4 = _mm_add_epi8(count4, _mm_load_si128(reinterpret_cast<const __m128i*>(starts[2].rows[row - k])));
+        }
+
+        const int offset = y * Bitboard::kStride;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&counts.by_size[1][offset]), count1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&counts.by_size[2][offset]), count2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&counts.by_size[3][offset]), count3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&counts.by_size[4][offset]), count4);
+    }
+}
+
+
+// То же, что CountSse2, но по две строки за раз: байтовые сдвиги AVX2 идут внутри 128-битных
+// половин регистра, то есть внутри каждой строки, а соседние строки лежат в памяти подряд.
+__attribute__((target("avx2")))
+void CountAvx2(const Bitboard& free_cells, PlacementCounts& counts) {
+    ByteRows cells;
+    ExpandRows(free_cells, cells);
+    counts.by_size[0].fill(0);
+
+    ByteRows starts[3];
+    std::memset(starts, 0, sizeof(starts));
+    for (int y = 0; y < kRows; y += 2) {
+        const int row = kPad + y;
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(cells.rows[row]));
+        for (int size = 2; size <= Ship::kMaxSize; ++size) {
+            v = _mm256_and_si256(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells.rows[row + size - 1])));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(starts[size - 2].rows[row]), v);
+        }
+    }
+
+    for (int y = 0; y < kRows; y += 2) {
+        const int row = kPad + y;
+        const __m256i c = _mm256_load_si256(reinterpret_cast<const __m256i*>(cells.rows[row]));
+
+        const __m256i h1 = c;
+        const __m256i h2 = _mm256_and_si256(h1, _mm256_srli_si256(c, 1));
+        const __m256i h3 = _mm256_and_si256(h2, _mm256_srli_si256(c, 2));
+        const __m256i h4 = _mm256_and_si256(h3, _mm256_srli_si256(c, 3));
+
+        const __m256i count1 = h1;
+        __m256i count2 = _mm256_add_epi8(h2, _mm256_slli_si256(h2, 1));
+        __m256i count3 = _mm256_add_epi8(_mm256_add_epi8(h3, _mm256_slli_si256(h3, 1)), _mm256_slli_si256(h3, 2));
+        __m256i count4 = _mm256_add_epi8(_mm256_add_epi8(h4, _mm256_slli_si256(h4, 1)),
+                                         _mm256_add_epi8(_mm256_slli_si256(h4, 2), _mm256_slli_si256(h4, 3)));
+
+        for (int k = 0; k < 2; ++k) {
+            count2 = _mm256_add_epi8(count2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(starts[0].rows[row - k])));
+        }
+        for (int k = 0; k < 3; ++k) {
+            count3 = _mm256_add_epi8(count3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(starts[1].rows[row - k])));
+        }
+        for (int k = 0; k < 4; ++k) {
+            count4 = _mm256_add_epi8(count4, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(starts[2].rows[row - k])));
+        }
+
+        const int offset = y * Bitboard::kStride;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&counts.by_size[1][offset]), count1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&counts.by_size[2][offset]), count2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&counts.by_size[3][offset]), count3);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&counts.by_size[4][offset]), count4);
+    }
+}
+
+#endif
+
+}
+
+
+void CountPlacements(const Bitboard& free_cells, PlacementCounts& counts, SimdKernel kernel) {
+    // Версия, которую процессор не поддерживает, заменяется на SCALAR.
+    if (!IsSimdKernelSupported(kernel)) {
+        kernel = SimdKernel::SCALAR;
+    }
+    switch (kernel) {
+#ifdef BATTLESHIP_X86_PLACEMENT_KERNELS
+        case SimdKernel::AVX2:
+            CountAvx2(free_cells, counts);
+            return;
+        case SimdKernel::SSE2:
+            CountSse2(free_cells, counts);
+            return;
+#endif
+        default:
+            CountScalar(free_cells, counts);
+            return;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef BATTLESHIP_TOOLS_PLACEMENTCOUNTER_H_
+#define BATTLESHIP_TOOLS_PLACEMENTCOUNTER_H_
+
+#include <array>
+#include <cstdint>
+#include "core/Bitboard.h"
+#include "core/Ship.h"
+#include "core/SimdKernel.h"
+
+// Число позиций корабля каждой длины, накрывающих клетку: by_size[size][Bitboard::BitIndex(x, y)].
+struct PlacementCounts {
+    std::array<std::array<std::uint8_t, Bitboard::kWords * 64>, Ship::kMaxSize + 1> by_size;
+};
+
+// Подсчёт позиций кораблей всех длин, целиком лежащих в свободных клетках, за один проход.
+// Это только материал для замеров placement_bench: игра его не вызывает.
+//
+// Позиция длины L начинается в клетке, если свободны L клеток подряд по строке или по столбцу,
+// а клетку накрывают позиции, начавшиеся не дальше чем за L - 1 клеток до неё. Векторные
+// версии держат по байту на клетку и строку поля в одном 16-байтовом регистре (в AVX2 — две
+// строки), поэтому окна вдоль строки — это байтовые сдвиги, а вдоль столбца — соседние строки.
+// Версию задаёт вызывающий; неподдерживаемая процессором заменяется на SCALAR.
+// Клетки вне поля в free_cells должны быть пустыми.
+//
+// В игре такой подсчёт не нужен: AIObservation ведёт свои счётчики позиций пошагово и учитывает
+// ещё и попадания, которые позиция должна накрыть, поэтому ни одна стратегия его не использует.
+void CountPlacements(const Bitboard& free_cells, PlacementCounts& counts, SimdKernel kernel);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef BATTLESHIP_TOOLS_TOOLOPTIONS_H_
+#define BATTLESHIP_TOOLS_TOOLOPTIONS_H_
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "core/Ship.h"
+
+// Общее для консольных инструментов из tools: разбор флота и доверительные интервалы.
+
+// Множитель половины 95% доверительного интервала нормального распределения.
+constexpr double kZ95 = 1.96;
+
+// Флот из размеров кораблей через запятую, например 4,3,3,2. false — если размер не от 1
+// до Ship::kMaxSize или флот пуст.
+inline bool ParseFleet(const std::string& text, std::vector<int>& fleet) {
+    fleet.clear();
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        const int size = std::atoi(item.c_str());
+        if (size < 1 || size > Ship::kMaxSize) return false;
+        fleet.push_back(size);
+    }
+    return !fleet.empty();
+}
+
+#endif
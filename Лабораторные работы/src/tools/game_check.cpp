@@ -0,0 +1,198 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "controlGame/Game.h"
+
+// Проверки Game, которые нельзя увидеть по одной партии в консоли. Печатает по строке на
+// проверку и завершается с кодом 1, если хоть одна нашла ошибку.
+//
+//   seed         — партия с зерном повторяется: та же расстановка, те же способности, те же
+//                  выстрелы ИИ, успел ли пул расстановок заполниться или нет; другое зерно даёт
+//                  другую партию. Печатает отпечаток записей партий: при рефакторинге, который
+//                  не должен менять партии с зерном, он совпадает до и после.
+//   observation  — AIObservation, которое ИИ обновляет по ходу, после каждого хода совпадает
+//                  с построенным заново по видимому полю; ИИ не стреляет по открытой клетке,
+//                  после победы ИИ игра ждёт следующего раунда.
+//   speculation  — ходы ИИ с зерном не зависят от того, успел ли заранее посчитанный ход
+//                  (AIMovePlanner) закончиться, пока человек думал, и от способностей человека.
+//
+// Использование: game_check [seed] [observation] [speculation]; без аргументов — все проверки.
+
+namespace {
+
+const std::vector<int> kFleet = {4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+
+void StartRound(Game& game) {
+    game.MoveAIShips();
+    game.MoveRandomShips();
+    game.set_player_turn_status();
+}
+
+
+// Поле человека, способности и все выстрелы ИИ до потопления флота человека.
+std::string PlayAIGame(std::uint64_t seed, bool wait_for_pool) {
+    GameSettings settings;
+    settings.set_seed(seed);
+    Game game(settings);
+    if (wait_for_pool) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    StartRound(game);
+    std::ostringstream record;
+    record << game.player_field() << game.ShowAbility() << "\n";
+    while (!game.player_field().IsAllShipsDestroyed()) {
+        const AttackResult result = game.MakeAIMove();
+        record << result.x << result.y << result.hit << ' ';
+    }
+    return record.str();
+}
+
+
+int CheckSeed() {
+    int errors = 0;
+    std::uint64_t fingerprint = 14695981039346656037ull;
+    for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+        const std::string first = PlayAIGame(seed, false);
+        if (first != PlayAIGame(seed, true)) {
+            std::printf("  зерно %llu: партия зависит от пула расстановок\n", static_cast<unsigned long long>(seed));
+            ++errors;
+        }
+        if (first == PlayAIGame(seed + 1000, true)) {
+            std::printf("  зерно %llu: партия совпала с партией другого зерна\n", static_cast<unsigned long long>(seed));
+            ++errors;
+        }
+        for (unsigned char c : first) {
+            fingerprint = (fingerprint ^ c) * 1099511628211ull;
+        }
+    }
+    std::printf("seed: ошибок %d, отпечаток партий %016llx\n", errors, static_cast<unsigned long long>(fingerprint));
+    return errors;
+}
+
+
+bool SameObservation(const AIObservation& a, const AIObservation& b, int side) {
+    if (a.water() != b.water() || a.hits() != b.hits() || a.sunk() != b.sunk()) return false;
+    for (int size = 1; size <= Ship::kMaxSize; ++size) {
+        if (a.alive_ships_of_size(size) != b.alive_ships_of_size(size)) return false;
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                if (a.placement_count(size, x, y) != b.placement_count(size, x, y)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+int CheckObservation() {
+    constexpr int kGames = 200;
+    int errors = 0;
+    long long shots = 0;
+    for (int g = 0; g < kGames; ++g) {
+        GameSettings settings;
+        settings.set_seed(g + 1);
+        Game game(settings);
+        StartRound(game);
+        const int side = game.player_field().x_size();
+        AIObservation mirror = AIObservation::FromVisibleField(game.player_field(), kFleet);
+        while (!game.player_field().IsAllShipsDestroyed()) {
+            const AttackResult result = game.MakeAIMove();
+            ++shots;
+            if (result.hit < 0) {
+                std::printf("  партия %d: ИИ выстрелил по открытой клетке\n", g);
+                ++errors;
+                break;
+            }
+            mirror.Record(result.x, result.y, result.hit);
+            if (!SameObservation(mirror, AIObservation::FromVisibleField(game.player_field(), kFleet), side)) {
+                std::printf("  партия %d: наблюдение после хода %lld не совпало с видимым полем\n", g, shots);
+                ++errors;
+                break;
+            }
+        }
+        if (game.game_status() != GameStatus::WAITING_NEXT_ROUND) {
+            std::printf("  партия %d: после победы ИИ статус %d\n", g, static_cast<int>(game.game_status()));
+            ++errors;
+        }
+    }
+    std::printf("observation: ошибок %d, выстрелов ИИ в среднем %.2f\n", errors,
+                static_cast<double>(shots) / kGames);
+    return errors;
+}
+
+
+// Ходы ИИ в партии, где человек стреляет по клеткам подряд и думает think_ms перед каждым ходом.
+std::string PlayAgainstHuman(std::uint64_t seed, AIDifficulty difficulty, int think_ms, bool use_abilities) {
+    GameSettings settings;
+    settings.set_seed(seed);
+    settings.set_ai_difficulty(difficulty);
+    Game game(settings);
+    StartRound(game);
+    std::ostringstream record;
+    const int side = game.enemy_field().x_size();
+    for (int n = 0; n < side * side; ++n) {
+        if (game.player_field().IsAllShipsDestroyed() || game.enemy_field().IsAllShipsDestroyed()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(think_ms));
+        if (use_abilities && n % 7 == 3) {
+            try {
+                game.UseAbility(n % side, n / side);
+            } catch (const std::exception&) {
+            }
+        }
+        if (game.game_status() == GameStatus::PLAYER_TURN) {
+            game.AttackShipAt(n % side, n / side);
+        }
+        const AttackResult result = game.MakeAIMove();
+        record << result.x << result.y << result.hit << ' ';
+    }
+    return record.str();
+}
+
+
+int CheckSpeculation() {
+    int errors = 0;
+    for (std::uint64_t seed = 1; seed <= 6; ++seed) {
+        for (AIDifficulty difficulty : {AIDifficulty::MEDIUM, AIDifficulty::HARD}) {
+            for (bool use_abilities : {false, true}) {
+                if (PlayAgainstHuman(seed, difficulty, 0, use_abilities) !=
+                    PlayAgainstHuman(seed, difficulty, 30, use_abilities)) {
+                    std::printf("  зерно %llu, сложность %d%s: ходы ИИ зависят от времени хода человека\n",
+                                static_cast<unsigned long long>(seed), static_cast<int>(difficulty),
+                                use_abilities ? ", со способностями" : "");
+                    ++errors;
+                }
+            }
+        }
+    }
+    std::printf("speculation: ошибок %d\n", errors);
+    return errors;
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    std::vector<std::string> checks(argv + 1, argv + argc);
+    if (checks.empty()) {
+        checks = {"seed", "observation", "speculation"};
+    }
+    int errors = 0;
+    for (const std::string& check : checks) {
+        if (check == "seed") {
+            errors += CheckSeed();
+        } else if (check == "observation") {
+            errors += CheckObservation();
+        } else if (check == "speculation") {
+            errors += CheckSpeculation();
+        } else {
+            std::fprintf(stderr, "Использование: %s [seed] [observation] [speculation]\n", argv[0]);
+            return 2;
+        }
+    }
+    return errors == 0 ? 0 : 1;
+}
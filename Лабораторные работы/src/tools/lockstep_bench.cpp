@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "core/AIObservation.h"
+#include "core/LayoutSampler.h"
+#include "core/LockstepSimulator.h"
+#include "core/PlayingField.h"
+#include "core/TargetingStrategy.h"
+#include "tools/ToolOptions.h"
+
+// Сравнение LockstepSimulator с партиями по одной. Все версии играют одним стрелком на одних
+// и тех же расстановках; время расстановок считается отдельно, средние числа выстрелов должны
+// совпадать в пределах разброса. Ускорение считается от lockstep/scalar — партий по одной на
+// тех же битовых досках и той же выборке клетки, что у дорожек: так видно, что даёт сама игра
+// по дорожкам. Строка PlayingField — та же партия через PlayingField, AIObservation и HuntTargeting.
+//
+// Использование: lockstep_bench [-g партий] [-s зерно] [-n размер поля] [-f флот, например 4,3,3,2]
+
+namespace {
+
+struct Options {
+    long long games = 20000;
+    std::uint64_t seed = 1;
+    int field_size = 10;
+    std::vector<int> fleet = {4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+};
+
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-g" && has_value) {
+            options.games = std::atoll(argv[++i]);
+        } else if (arg == "-s" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "-n" && has_value) {
+            options.field_size = std::atoi(argv[++i]);
+        } else if (arg == "-f" && has_value) {
+            if (!ParseFleet(argv[++i], options.fleet)) return false;
+        } else {
+            return false;
+        }
+    }
+    return options.games >= 2 && options.field_size >= 1 && options.field_size <= Bitboard::kMaxSide;
+}
+
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int PlayOne(const Options& options, const std::vector<ShipPlacement>& layout, Rng& rng) {
+    PlayingField field(options.field_size, options.field_size);
+    for (const ShipPlacement& ship : layout) {
+        field.PlaceShip(ship.x, ship.y, ship.size, ship.orientation);
+    }
+    AIObservation observation(options.field_size, options.field_size, options.fleet);
+    HuntTargeting strategy;
+    int shots = 0;
+    int x = -1, y = -1;
+    while (!field.IsAllShipsDestroyed() && strategy.ChooseTarget(observation, rng, x, y)) {
+        observation.Record(x, y, field.Damage(x, y));
+        ++shots;
+    }
+    return shots;
+}
+
+
+void PrintRow(const char* name, const std::vector<int>& shots, double seconds, double baseline) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (int s : shots) {
+        sum += s;
+        sum_sq += static_cast<double>(s) * s;
+    }
+    const double n = static_cast<double>(shots.size());
+    const double mean = sum / n;
+    const double variance = (sum_sq - mean * sum) / (n - 1);
+    const double rate = n / seconds;
+    std::printf("  %-16s %10.0f партий/с  %6.2fx  выстрелов: %.2f ± %.2f\n", name, rate,
+                rate / baseline, mean, kZ95 * std::sqrt(variance / n));
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Использование: %s [-g партий] [-s зерно] [-n размер поля] [-f флот, например 4,3,3,2]\n",
+                     argv[0]);
+        return 2;
+    }
+    const int side = options.field_size;
+
+    Rng placement_rng(options.seed);
+    std::vector<std::vector<ShipPlacement>> layouts(static_cast<std::size_t>(options.games));
+    auto start = std::chrono::steady_clock::now();
+    for (std::vector<ShipPlacement>& layout : layouts) {
+        if (!GenerateFleetLayout(side, side, options.fleet, placement_rng, layout)) {
+            std::fprintf(stderr, "Флот не помещается на поле %dx%d\n", side, side);
+            return 1;
+        }
+    }
+    std::printf("Поле %dx%d, %lld расстановок за %.2f с (в сравнение не входят)\n", side, side,
+                options.games, Seconds(start));
+
+    // Точка отсчёта: партии по одной на битовых досках.
+    LockstepSimulator scalar(side, side, SimdKernel::SCALAR);
+    Rng scalar_rng(options.seed + 1);
+    std::vector<int> scalar_shots;
+    start = std::chrono::steady_clock::now();
+    scalar.Run(layouts, scalar_rng, scalar_shots);
+    const double scalar_seconds = Seconds(start);
+    const double baseline_rate = static_cast<double>(layouts.size()) / scalar_seconds;
+
+    Rng field_rng(options.seed + 1);
+    std::vector<int> field_shots(layouts.size());
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < layouts.size(); ++i) {
+        field_shots[i] = PlayOne(options, layouts[i], field_rng);
+    }
+    PrintRow("PlayingField", field_shots, Seconds(start), baseline_rate);
+    PrintRow("lockstep/scalar", scalar_shots, scalar_seconds, baseline_rate);
+
+    if (!IsSimdKernelSupported(SimdKernel::AVX2)) {
+        std::printf("  %-16s не поддерживается\n", "lockstep/avx2");
+        return 0;
+    }
+    LockstepSimulator simulator(side, side, SimdKernel::AVX2);
+    Rng lane_rng(options.seed + 1);
+    std::vector<int> shots;
+    start = std::chrono::steady_clock::now();
+    simulator.Run(layouts, lane_rng, shots);
+    PrintRow("lockstep/avx2", shots, Seconds(start), baseline_rate);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "tools/PlacementCounter.h"
+
+// Сравнение версий CountPlacements на полях 10x10 и 14x14. Подсчёт существует только ради
+// этого замера: игра его не вызывает.
+// Свободные клетки — случайные маски с долей занятых клеток 30%, как в середине партии.
+
+namespace {
+
+constexpr int kMasks = 1024;
+constexpr int kRounds = 2000;
+
+std::vector<Bitboard> RandomMasks(int side, std::mt19937& gen) {
+    std::bernoulli_distribution blocked(0.3);
+    std::vector<Bitboard> masks(kMasks);
+    for (Bitboard& mask : masks) {
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                if (!blocked(gen)) mask.Set(x, y);
+            }
+        }
+    }
+    return masks;
+}
+
+bool SameCounts(const PlacementCounts& a, const PlacementCounts& b) {
+    return a.by_size == b.by_size;
+}
+
+}
+
+
+int main() {
+    std::mt19937 gen(2024);
+    const SimdKernel kernels[] = {SimdKernel::SCALAR, SimdKernel::SSE2, SimdKernel::AVX2};
+
+    for (int side : {10, 14}) {
+        const std::vector<Bitboard> masks = RandomMasks(side, gen);
+        std::printf("Поле %dx%d:\n", side, side);
+
+        for (SimdKernel kernel : kernels) {
+            if (!IsSimdKernelSupported(kernel)) {
+                std::printf("  %-7s не поддерживается\n", SimdKernelName(kernel));
+                continue;
+            }
+
+            PlacementCounts expected;
+            PlacementCounts counts;
+            for (const Bitboard& mask : masks) {
+                CountPlacements(mask, expected, SimdKernel::SCALAR);
+                CountPlacements(mask, counts, kernel);
+                if (!SameCounts(expected, counts)) {
+                    std::printf("  %-7s ОШИБКА: результат отличается от scalar\n", SimdKernelName(kernel));
+                    return 1;
+                }
+            }
+
+            unsigned checksum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int round = 0; round < kRounds; ++round) {
+                for (const Bitboard& mask : masks) {
+                    CountPlacements(mask, counts, kernel);
+                    checksum += counts.by_size[Ship::kMaxSize][Bitboard::BitIndex(side / 2, side / 2)];
+                }
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  %-7s %8.1f нс на поле (контрольная сумма %u)\n", SimdKernelName(kernel),
+                        ns / (static_cast<double>(kRounds) * kMasks), checksum);
+        }
+    }
+    return 0;
+}
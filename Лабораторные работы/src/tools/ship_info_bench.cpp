@@ -0,0 +1,155 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "core/LayoutSampler.h"
+#include "core/PlayingField.h"
+
+// Стоимость PlayingField::ship_info_at до и после поиска по клетке реального поля.
+// «Перебор» — прежняя реализация: segment_index каждого корабля флота по очереди.
+//
+// Кадр — ship_info_at для каждой клетки поля, как у ConsoleRenderer::CellGlyph и
+// GUIRenderer::RenderField. Ход ИИ — ship_info_at для каждой открытой клетки корабля после
+// каждого выстрела, как при сборке AIObservation::FromVisibleField по видимому полю.
+// Выстрелы идут по клеткам в случайном порядке, пока флот не потоплен.
+
+namespace {
+
+constexpr int kLayouts = 64;
+constexpr int kFrameRounds = 200;
+
+struct Fleet {
+    int side;
+    std::vector<int> sizes;
+};
+
+
+bool ScanShips(const PlayingField& field, int x, int y, int& ship_index, int& segment_index, int& ship_size,
+               SegmentState& segment_state, Orientation& orientation) {
+    for (int i = 0; i < field.ship_slot_count(); ++i) {
+        if (!field.IsShipPlaced(i)) continue;
+        const Ship& ship = field.ship(i);
+        const int index = ship.segment_index(Position(x, y));
+        if (index >= 0) {
+            ship_index = i;
+            segment_index = index;
+            ship_size = ship.ship_size();
+            segment_state = ship.segment_state(index);
+            orientation = ship.orientation();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool LookUp(const PlayingField& field, int x, int y, int& ship_index, int& segment_index, int& ship_size,
+            SegmentState& segment_state, Orientation& orientation) {
+    return field.ship_info_at(x, y, ship_index, segment_index, ship_size, segment_state, orientation);
+}
+
+
+using Lookup = bool (*)(const PlayingField&, int, int, int&, int&, int&, SegmentState&, Orientation&);
+
+// Сумма ответов: по ней видно, что обе версии отвечают одинаково, и компилятор не выбросит вызовы.
+long long QueryCells(const PlayingField& field, Lookup lookup, bool revealed_only) {
+    long long sum = 0;
+    for (int y = 0; y < field.y_size(); ++y) {
+        for (int x = 0; x < field.x_size(); ++x) {
+            if (revealed_only && !field.visible_cell(x, y).IsShip()) continue;
+            int ship_index, segment_index, ship_size;
+            SegmentState segment_state;
+            Orientation orientation;
+            if (lookup(field, x, y, ship_index, segment_index, ship_size, segment_state, orientation)) {
+                sum += ship_index * 16 + segment_index * 4 + static_cast<int>(segment_state) + ship_size +
+                       static_cast<int>(orientation);
+            }
+        }
+    }
+    return sum;
+}
+
+
+std::vector<PlayingField> MakeFields(const Fleet& fleet, Rng& rng) {
+    std::vector<PlayingField> fields;
+    std::vector<ShipPlacement> layout;
+    for (int i = 0; i < kLayouts; ++i) {
+        GenerateFleetLayout(fleet.side, fleet.side, fleet.sizes, rng, layout);
+        PlayingField field(fleet.side, fleet.side);
+        for (const ShipPlacement& ship : layout) {
+            field.PlaceShip(ship.x, ship.y, ship.size, ship.orientation);
+        }
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+
+double FrameNanoseconds(const std::vector<PlayingField>& fields, Lookup lookup, long long& checksum) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kFrameRounds; ++round) {
+        for (const PlayingField& field : fields) {
+            checksum += QueryCells(field, lookup, false);
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / (kFrameRounds * static_cast<double>(fields.size()));
+}
+
+
+// Время только запросов ship_info_at; сами выстрелы в него не входят.
+double MoveNanoseconds(const std::vector<PlayingField>& fields, Lookup lookup, long long& checksum) {
+    Rng rng(7);
+    double ns = 0.0;
+    long long moves = 0;
+    for (PlayingField field : fields) {
+        std::vector<int> cells(field.x_size() * field.y_size());
+        for (int i = 0; i < static_cast<int>(cells.size()); ++i) cells[i] = i;
+        for (int i = static_cast<int>(cells.size()) - 1; i > 0; --i) {
+            std::swap(cells[i], cells[UniformBelow(rng, static_cast<std::uint32_t>(i + 1))]);
+        }
+        for (int cell : cells) {
+            if (field.IsAllShipsDestroyed()) break;
+            const int x = cell % field.x_size();
+            const int y = cell / field.x_size();
+            // По клетке стреляют, пока выстрел что-то меняет: клетке корабля нужно два попадания.
+            while (field.Damage(x, y) >= 0) {
+                const auto start = std::chrono::steady_clock::now();
+                checksum += QueryCells(field, lookup, true);
+                ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                ++moves;
+            }
+        }
+    }
+    return ns / static_cast<double>(moves);
+}
+
+}
+
+
+int main() {
+    const Fleet fleets[] = {
+        {10, {4, 3, 3, 2, 2, 2, 1, 1, 1, 1}},
+        {14, {4, 4, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1}},
+    };
+    Rng rng(2024);
+    for (const Fleet& fleet : fleets) {
+        const std::vector<PlayingField> fields = MakeFields(fleet, rng);
+        long long scan_frame = 0, lookup_frame = 0, scan_move = 0, lookup_move = 0;
+        const double scan_frame_ns = FrameNanoseconds(fields, ScanShips, scan_frame);
+        const double lookup_frame_ns = FrameNanoseconds(fields, LookUp, lookup_frame);
+        const double scan_move_ns = MoveNanoseconds(fields, ScanShips, scan_move);
+        const double lookup_move_ns = MoveNanoseconds(fields, LookUp, lookup_move);
+        if (scan_frame != lookup_frame || scan_move != lookup_move) {
+            std::printf("ОШИБКА: ship_info_at отвечает не так, как перебор кораблей\n");
+            return 1;
+        }
+        std::printf("Поле %dx%d, кораблей %zu:\n", fleet.side, fleet.side, fleet.sizes.size());
+        std::printf("  кадр    перебор %8.0f нс  ship_info_at %8.0f нс  %5.1fx\n", scan_frame_ns, lookup_frame_ns,
+                    scan_frame_ns / lookup_frame_ns);
+        std::printf("  ход ИИ  перебор %8.0f нс  ship_info_at %8.0f нс  %5.1fx\n", scan_move_ns, lookup_move_ns,
+                    scan_move_ns / lookup_move_ns);
+    }
+    return 0;
+}
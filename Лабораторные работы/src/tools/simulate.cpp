@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+#include "controlGame/SimulationRunner.h"
+#include "tools/ToolOptions.h"
+
+// Пакет партий ИИ против ИИ по полным правилам игры (со способностями) на всех ядрах.
+// Печатает скорость и сводную статистику по обеим стратегиям.
+//
+// Использование: simulate [-g партий] [-t потоков] [-s зерно] [-n размер поля]
+//                         [-f флот, например 4,3,3,2] [-a 0|1 — способности] стратегия стратегия
+// Стратегии — как в tournament: random, hunt, density, posterior[:расстановок на ход[:расстановок для точного перебора]].
+
+namespace {
+
+bool ParseOptions(int argc, char** argv, SimulationSettings& settings, std::vector<std::string>& strategies) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-g" && has_value) {
+            settings.matches = std::atoll(argv[++i]);
+        } else if (arg == "-t" && has_value) {
+            settings.threads = std::atoi(argv[++i]);
+        } else if (arg == "-s" && has_value) {
+            settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "-n" && has_value) {
+            settings.match.field_size = std::atoi(argv[++i]);
+        } else if (arg == "-f" && has_value) {
+            if (!ParseFleet(argv[++i], settings.match.fleet)) return false;
+        } else if (arg == "-a" && has_value) {
+            settings.match.abilities = std::atoi(argv[++i]) != 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            if (!MakeTargetingStrategy(arg)) {
+                std::fprintf(stderr, "Неизвестная стратегия: %s\n", arg.c_str());
+                return false;
+            }
+            strategies.push_back(arg);
+        }
+    }
+    if (strategies.empty()) {
+        strategies = {"density", "posterior:256:0"};
+    }
+    return strategies.size() == 2 && settings.matches >= 1 && settings.threads >= 0 &&
+           settings.match.field_size >= 1 && settings.match.field_size <= Bitboard::kMaxSide;
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    SimulationSettings settings;
+    std::vector<std::string> strategies;
+    if (!ParseOptions(argc, argv, settings, strategies)) {
+        std::fprintf(stderr,
+                     "Использование: %s [-g партий] [-t потоков] [-s зерно] [-n размер поля]\n"
+                     "                  [-f флот, например 4,3,3,2] [-a 0|1] стратегия стратегия\n"
+                     "Стратегии: random, hunt, density, posterior[:расстановок на ход[:расстановок для точного перебора]]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    const SimulationRunner runner(settings, {[&] { return MakeTargetingStrategy(strategies[0]); },
+                                             [&] { return MakeTargetingStrategy(strategies[1]); }});
+    SimulationReport report;
+    try {
+        report = runner.Run();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    const double matches = static_cast<double>(report.matches);
+    std::printf("Поле %dx%d, флот", settings.match.field_size, settings.match.field_size);
+    for (int size : settings.match.fleet) std::printf(" %d", size);
+    std::printf(", способности: %s, потоков: %d\n", settings.match.abilities ? "да" : "нет", report.threads);
+    std::printf("Сыграно %lld партий за %.2f с: %.0f партий/с\n", report.matches, report.seconds,
+                report.games_per_second());
+    std::printf("Ходов за партию: %.1f, ничьих: %lld, первый ход выиграл: %.1f%%\n\n",
+                static_cast<double>(report.turns) / matches, report.draws,
+                100.0 * static_cast<double>(report.first_mover_wins) / matches);
+
+    for (int s = 0; s < 2; ++s) {
+        const StrategyTotals& totals = report.strategies[s];
+        const double wins = static_cast<double>(totals.wins);
+        const double win_rate = wins / matches;
+        std::printf("%s:\n", strategies[s].c_str());
+        std::printf("  побед: %.1f ± %.1f%%\n", 100.0 * win_rate,
+                    100.0 * kZ95 * std::sqrt(win_rate * (1.0 - win_rate) / matches));
+        if (totals.wins > 1) {
+            const double mean = static_cast<double>(totals.shots_to_win) / wins;
+            const double variance = (totals.shots_to_win_sq - mean * static_cast<double>(totals.shots_to_win)) / (wins - 1);
+            std::printf("  выстрелов до победы: %.2f ± %.2f\n", mean, kZ95 * std::sqrt(std::max(0.0, variance) / wins));
+        }
+        std::printf("  точность: %.1f%%\n",
+                    totals.shots > 0 ? 100.0 * static_cast<double>(totals.hits) / static_cast<double>(totals.shots) : 0.0);
+        std::printf("  потоплено кораблей за партию: %.2f\n", static_cast<double>(totals.ships_destroyed) / matches);
+        std::printf("  способностей за партию: %.2f\n", static_cast<double>(totals.abilities_used) / matches);
+    }
+    return 0;
+}
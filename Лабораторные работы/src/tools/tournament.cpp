@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/AIObservation.h"
+#include "core/PlacementStrategy.h"
+#include "core/PlayingField.h"
+#include "core/ShipManager.h"
+#include "core/TargetingStrategy.h"
+#include "tools/ToolOptions.h"
+
+// Турнир стратегий стрельбы ИИ: каждая пара стратегий играет серию партий на всех ядрах,
+// в конце — доля побед, среднее число выстрелов до победы с 95% доверительными интервалами и Elo.
+//
+// Без способностей выстрелы одного игрока не меняют поле другого, поэтому каждая сторона
+// добивает флот противника до конца, а побеждает та, которой понадобилось меньше выстрелов;
+// при равенстве — та, что ходила первой. Значит, число выстрелов стратегии по полю не зависит
+// от противника, и каждая стратегия играет каждое поле ровно один раз, а исходы всех партий
+// получаются сравнением этих чисел. Поле и генератор стрелка зависят только от зерна турнира
+// и номера поля, поэтому все стратегии стреляют по одним и тем же полям, а итог не зависит
+// от числа потоков. Партии идут парами на двух полях: во второй партии стороны меняются полями
+// и очерёдностью хода, и везение с расстановкой и первым ходом из сравнения уходит.
+//
+// Использование: tournament [-g партий на пару] [-t потоков] [-s зерно] [-n размер поля]
+//                           [-f флот, например 4,3,3,2] стратегия...
+// Стратегии: random, hunt, density, posterior[:расстановок на ход[:расстановок для точного перебора]];
+// например, posterior:256:0 — 256 расстановок на ход и без точного перебора в конце раунда.
+
+namespace {
+
+// Столько полей подряд берёт поток за раз.
+constexpr int kBoardsPerTask = 32;
+
+struct Options {
+    long long games = 100000;
+    int threads = 0;
+    std::uint64_t seed = 1;
+    int side = 10;
+    std::vector<int> fleet = {4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+    std::vector<std::string> strategies;
+};
+
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-g" && has_value) {
+            options.games = std::atoll(argv[++i]);
+        } else if (arg == "-t" && has_value) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "-s" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "-n" && has_value) {
+            options.side = std::atoi(argv[++i]);
+        } else if (arg == "-f" && has_value) {
+            if (!ParseFleet(argv[++i], options.fleet)) return false;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            if (!MakeTargetingStrategy(arg)) {
+                std::fprintf(stderr, "Неизвестная стратегия: %s\n", arg.c_str());
+                return false;
+            }
+            options.strategies.push_back(arg);
+        }
+    }
+    if (options.strategies.empty()) {
+        options.strategies = {"random", "density", "posterior:256:0"};
+    }
+    return options.strategies.size() >= 2 && options.games >= 2 && options.threads >= 0 &&
+           options.side >= 1 && options.side <= Bitboard::kMaxSide;
+}
+
+
+// Сколько выстрелов нужно стратегии, чтобы потопить флот на поле board; -1 — стратегия
+// не нашла цель или стреляет впустую.
+int PlayBoard(const Options& options, const ShipManager& manager, const PlacementStrategy& placement,
+              TargetingStrategy& targeting, std::uint64_t board) {
+    GameRandom random(Rng(options.seed ^ (board * 0x9E3779B97F4A7C15ull))());
+    PlayingField field(options.side, options.side);
+    if (!field.SetRandomShips(manager, random.placement(), placement)) {
+        return -1;
+    }
+
+    AIObservation observation(options.side, options.side, options.fleet);
+    const int max_shots = 2 * options.side * options.side;
+    int shots = 0;
+    while (!field.IsAllShipsDestroyed()) {
+        int x = -1, y = -1;
+        if (shots == max_shots || !targeting.ChooseTarget(observation, random.ai(), x, y)) {
+            return -1;
+        }
+        const int result = field.Damage(x, y);
+        observation.Record(x, y, result);
+        ++shots;
+    }
+    return shots;
+}
+
+
+struct Mean {
+    double value = 0.0;
+    double half_width = 0.0;
+};
+
+Mean MeanWithInterval(double sum, double sum_sq, double count) {
+    Mean mean;
+    mean.value = sum / count;
+    const double variance = std::max(0.0, (sum_sq - sum * mean.value) / (count - 1));
+    mean.half_width = kZ95 * std::sqrt(variance / count);
+    return mean;
+}
+
+
+// Рейтинги Elo по модели Брэдли — Терри: сила каждой стратегии подбирается методом
+// минорирования-максимизации так, чтобы ожидаемые победы совпали с набранными. К каждой паре
+// добавляется по половине победы в обе стороны, чтобы стратегия без поражений не ушла в бесконечность.
+std::vector<double> EloRatings(const std::vector<std::vector<double>>& wins) {
+    const std::size_t n = wins.size();
+    std::vector<double> strength(n, 1.0);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        std::vector<double> next(n);
+        double max_change = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            double won = 0.0, denominator = 0.0;
+            for (std::size_t j = 0; j < n; ++j) {
+                if (i == j) continue;
+                won += wins[i][j] + 0.5;
+                denominator += (wins[i][j] + wins[j][i] + 1.0) / (strength[i] + strength[j]);
+            }
+            next[i] = won / denominator;
+        }
+        double log_sum = 0.0;
+        for (double s : next) log_sum += std::log(s);
+        const double scale = std::exp(log_sum / static_cast<double>(n));
+        for (std::size_t i = 0; i < n; ++i) {
+            next[i] /= scale;
+            max_change = std::max(max_change, std::fabs(std::log(next[i] / strength[i])));
+        }
+        strength = next;
+        if (max_change < 1e-12) break;
+    }
+
+    std::vector<double> elo(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        elo[i] = 1500.0 + 400.0 * std::log10(strength[i]);
+    }
+    return elo;
+}
+
+
+
+std::string Format(const char* format, double a, double b = 0.0) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), format, a, b);
+    return buffer;
+}
+
+
+// printf выравнивает по байтам, а русские буквы и «±» занимают по два байта.
+void PrintCell(const std::string& text, int width, bool left) {
+    int length = 0;
+    for (char c : text) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) ++length;
+    }
+    const std::string padding(static_cast<std::size_t>(std::max(0, width - length)), ' ');
+    std::printf("%s%s%s", left ? "" : padding.c_str(), text.c_str(), left ? padding.c_str() : "");
+}
+
+}
+
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "Использование: %s [-g партий на пару] [-t потоков] [-s зерно] [-n размер поля]\n"
+                     "                  [-f флот, например 4,3,3,2] стратегия стратегия...\n"
+                     "Стратегии: random, hunt, density, posterior[:расстановок на ход[:расстановок для точного перебора]]\n", argv[0]);
+        return 2;
+    }
+
+    const int strategy_count = static_cast<int>(options.strategies.size());
+    // Каждая пара партий — два поля.
+    const long long rounds = options.games / 2;
+    const long long boards = 2 * rounds;
+    const int threads = options.threads > 0
+        ? options.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const ShipManager manager(static_cast<int>(options.fleet.size()), options.fleet);
+
+    // shots[s][b] — выстрелы стратегии s по полю b.
+    std::vector<std::vector<std::int16_t>> shots(strategy_count, std::vector<std::int16_t>(boards));
+    const long long tasks_per_strategy = (boards + kBoardsPerTask - 1) / kBoardsPerTask;
+    std::atomic<long long> next_task{0};
+    std::atomic<bool> failed{false};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto work = [&] {
+        const UniformPlacement placement(false);
+        std::vector<std::unique_ptr<TargetingStrategy>> strategies;
+        for (const std::string& spec : options.strategies) {
+            strategies.push_back(MakeTargetingStrategy(spec));
+        }
+        for (long long task = next_task++; task < strategy_count * tasks_per_strategy && !failed;
+             task = next_task++) {
+            const int s = static_cast<int>(task / tasks_per_strategy);
+            const long long first = (task % tasks_per_strategy) * kBoardsPerTask;
+            const long long last = std::min(boards, first + kBoardsPerTask);
+            for (long long b = first; b < last; ++b) {
+                const int count = PlayBoard(options, manager, placement, *strategies[s], static_cast<std::uint64_t>(b));
+                if (count < 0) {
+                    failed = true;
+                    break;
+                }
+                shots[s][b] = static_cast<std::int16_t>(count);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failed) {
+        std::fprintf(stderr, "Флот не удалось расставить или стратегия не смогла его потопить\n");
+        return 1;
+    }
+
+    // Партия 2r: стратегия i на стороне 0 и ходит первой, стреляет по полю 2r + 1, а j — по полю 2r.
+    // Партия 2r + 1: стороны меняются полями, первой ходит j.
+    std::vector<std::vector<double>> wins(strategy_count, std::vector<double>(strategy_count, 0.0));
+    std::vector<std::vector<Mean>> win_rate(strategy_count, std::vector<Mean>(strategy_count));
+    for (int i = 0; i < strategy_count; ++i) {
+        for (int j = i + 1; j < strategy_count; ++j) {
+            double sum = 0.0, sum_sq = 0.0;
+            for (long long r = 0; r < rounds; ++r) {
+                const int first = shots[i][2 * r + 1] <= shots[j][2 * r] ? 1 : 0;
+                const int second = shots[i][2 * r] < shots[j][2 * r + 1] ? 1 : 0;
+                const double score = 0.5 * (first + second);
+                sum += score;
+                sum_sq += score * score;
+            }
+            // Доверительный интервал — по парам партий: партии одной пары играются на одних полях.
+            win_rate[i][j] = MeanWithInterval(sum, sum_sq, static_cast<double>(rounds));
+            win_rate[j][i] = {1.0 - win_rate[i][j].value, win_rate[i][j].half_width};
+            wins[i][j] = 2.0 * sum;
+            wins[j][i] = 2.0 * (static_cast<double>(rounds) - sum);
+        }
+    }
+    const std::vector<double> elo = EloRatings(wins);
+
+    const long long games = static_cast<long long>(strategy_count) * (strategy_count - 1) / 2 * boards;
+    std::printf("Поле %dx%d, флот", options.side, options.side);
+    for (int size : options.fleet) std::printf(" %d", size);
+    std::printf(", %lld партий на пару, потоков: %d\n", boards, threads);
+    std::printf("Сыграно %lld партий (%lld полей) за %.1f с: %.0f партий/с\n\n",
+                games, boards * strategy_count, seconds, games / seconds);
+
+    std::vector<int> order(strategy_count);
+    for (int i = 0; i < strategy_count; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return elo[a] > elo[b]; });
+    int name_width = 10;
+    for (const std::string& spec : options.strategies) {
+        name_width = std::max(name_width, static_cast<int>(spec.size()));
+    }
+
+    PrintCell("Стратегия", name_width, true);
+    PrintCell("Elo", 7, false);
+    PrintCell("Побед, %", 10, false);
+    PrintCell("Выстрелов до победы", 22, false);
+    std::printf("\n");
+    for (int i : order) {
+        double won = 0.0;
+        for (int j = 0; j < strategy_count; ++j) won += wins[i][j];
+        double sum = 0.0, sum_sq = 0.0;
+        for (std::int16_t count : shots[i]) {
+            sum += count;
+            sum_sq += static_cast<double>(count) * count;
+        }
+        const Mean shots_mean = MeanWithInterval(sum, sum_sq, static_cast<double>(boards));
+        PrintCell(options.strategies[i], name_width, true);
+        PrintCell(Format("%.0f", elo[i]), 7, false);
+        PrintCell(Format("%.1f", 100.0 * won / static_cast<double>((strategy_count - 1) * boards)), 10, false);
+        PrintCell(Format("%.2f ± %.2f", shots_mean.value, shots_mean.half_width), 22, false);
+        std::printf("\n");
+    }
+
+    std::printf("\nДоля побед стратегии строки над стратегией столбца, %%:\n");
+    PrintCell("", name_width, true);
+    for (int j : order) PrintCell(options.strategies[j], std::max(13, name_width) + 1, false);
+    std::printf("\n");
+    for (int i : order) {
+        PrintCell(options.strategies[i], name_width, true);
+        for (int j : order) {
+            const std::string cell = (i == j)
+                ? "—"
+                : Format("%.1f ± %.1f", 100.0 * win_rate[i][j].value, 100.0 * win_rate[i][j].half_width);
+            PrintCell(cell, std::max(13, name_width) + 1, false);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}